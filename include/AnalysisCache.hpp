@@ -0,0 +1,111 @@
+#ifndef AnalysisCache_h
+#define AnalysisCache_h 1
+
+#include "DecayChainCore.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * On-disk cache of the per-event analysis, so reruns only redo the drawing.
+ * Per event it holds the MC side once (PDG, generator status, flags, kinematics, all
+ * daughter relations, detector regions) and the vertex membership of every vertex collection.
+ * The file is tied to the identity (path, size, modification time) of the input files.
+ * A valid file is memory mapped and lookups return views into the mapping without copying,
+ * otherwise a new file is written during the job and moved in place by close().
+ * Binary layout in native byte order, every block 8-byte aligned:
+ * header, records (MC: header, pdg, generatorStatus, daughterOffsets, daughters, flags, distance, pt, pz,
+ * decayLength, eta, region if any; vertex collection: header, vertex), index sorted by (run, event, collection).
+ */
+class AnalysisCache {
+    public:
+        enum class Mode {off, read, write};
+
+        //MC side of an event, shared by its vertex collections
+        struct McRecord {
+            //particles, PDG, generator status and daughters, no parents or positions
+            McGraph graph{};
+            //flags without drawn
+            const uint8_t* flags{};
+            const double* distance{};
+            const double* pt{};
+            const double* pz{};
+            const double* decayLength{};
+            const double* eta{};
+            //null if the job had no region table
+            const int* region{};
+        };
+
+        //membership of one vertex collection as in EventAnalysis::vertex
+        struct VertexRecord {
+            const int* vertex{};
+            EventFeatures features{};
+        };
+
+        AnalysisCache() = default;
+        AnalysisCache(const AnalysisCache&) = delete;
+        AnalysisCache& operator=(const AnalysisCache&) = delete;
+        ~AnalysisCache();
+
+        //reads path if it is a cache of the same input files, else starts writing it
+        void open(const std::string& path, const std::vector<std::string>& inputFiles);
+        Mode mode() const {return _mode;}
+
+        //false if the MC side or any of the collections is not cached or not intact, counted as one hit or miss per event
+        bool find(int run, int event, const std::vector<std::string>& collections, McRecord& mc, std::vector<VertexRecord>& vertices);
+        //analysis after analyseMc, once per event
+        void addMc(int run, int event, const McGraph& graph, const EventAnalysis& analysis);
+        //analysis after analyseVertices
+        void addVertices(int run, int event, const std::string& collection, const EventAnalysis& analysis, const EventFeatures& features);
+        //writes the index and moves the new file in place, false on failure
+        bool close();
+
+        long nRecords() const {return _mode == Mode::write ? long(_index.size()) : _nRecords;}
+        long nHits() const {return _nHits;}
+        long nMisses() const {return _nMisses;}
+        //records of a (run, event, collection) written more than once, after close()
+        long nDuplicates() const {return _nDuplicates;}
+
+        static uint64_t getInputIdentity(const std::vector<std::string>& inputFiles);
+
+        struct IndexEntry {
+            int32_t run;
+            int32_t event;
+            uint64_t collection;
+            uint64_t offset;
+        };
+
+    private:
+        bool map(const std::string& path, uint64_t identity);
+        void unmap();
+        //start of the record, null if it is not in the index
+        const char* findRecord(int run, int event, uint64_t collection) const;
+        bool readMc(int run, int event, McRecord& mc) const;
+        bool readVertices(int run, int event, const std::vector<std::string>& collections, int nParticles, std::vector<VertexRecord>& vertices) const;
+        static uint64_t getNameHash(const std::string& name);
+
+        Mode _mode{};
+        std::string _path{};
+        uint64_t _identity{};
+
+        // read
+        const char* _data{};
+        size_t _size{};
+        const IndexEntry* _entries{};
+        //records end where the index starts
+        const char* _recordsEnd{};
+        long _nRecords{};
+        long _nHits{};
+        long _nMisses{};
+
+        // write
+        std::ofstream _file{};
+        std::vector<IndexEntry> _index{};
+        std::vector<uint8_t> _flags{};
+        long _nDuplicates{};
+};
+
+
+#endif
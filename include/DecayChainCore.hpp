@@ -0,0 +1,180 @@
+#ifndef DecayChainCore_h
+#define DecayChainCore_h 1
+
+#include "DetectorRegions.hpp"
+#include "Kinematics.hpp"
+#include "McGraph.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Read-only view of everything writeDotGraph needs, indexed like EventAnalysis.
+ * Backed by an EventAnalysis or by the mapped records of an AnalysisCache.
+ */
+struct DrawnGraph {
+    int nParticles{};
+    const int* pdg{};
+    const int* vertex{};
+    const double* distance{};
+    const double* pt{};
+    const double* pz{};
+    int nNodes{};
+    const int* nodes{};
+    int nEdges{};
+    const std::pair<int, int>* edges{};
+    int nLayoutGroups{};
+    const int* layoutGroup{};
+    //detector region of the production vertex, not drawn without
+    const int* region{};
+    const DetectorRegions* regions{};
+};
+
+/**
+ * Truth quality of one reconstructed vertex. A decay chain is named by its root: the particle
+ * right below the hadronization, or the first generator particle for anything outside of it.
+ */
+struct VertexMetrics {
+    int nTracks{};
+    int nTracksWithMc{};
+    //distinct decay chains of the tracks, more than one for merged vertices
+    int nChains{};
+    //tracks of the chain with most tracks
+    int nDominant{};
+    //distinct MC particles of the dominant chain in the vertex, and reconstructed but in no vertex of the collection
+    int nFound{};
+    int nMissed{};
+};
+
+/**
+ * Result of the decay chain analysis of one event.
+ * Everything is indexed by the particle index of the McGraph, arrays live in the memory
+ * resource given at construction and must be cleared before that resource is released.
+ */
+struct EventAnalysis {
+    enum Flag : uint8_t {inHadronization = 1, drawn = 2};
+
+    explicit EventAnalysis(std::pmr::memory_resource* resource);
+    void clear();
+    //valid until the next change of the analysis
+    DrawnGraph drawnGraph() const;
+
+    int nParticles{};
+    std::pmr::vector<int> pdg;
+    //index + 1 of the last vertex whose decay chain holds the particle, 0 if none
+    std::pmr::vector<int> vertex;
+    std::pmr::vector<uint8_t> flags;
+    Kinematics kinematics{};
+    //detector region of the production vertex, empty without a region table
+    std::pmr::vector<int> region;
+    const DetectorRegions* regions{};
+
+    //decay chains of the vertices of the current vertex collection, CSR as in McGraph
+    int nVertices{};
+    std::pmr::vector<int> chainOffsets;
+    std::pmr::vector<int> chainParticles;
+    //per vertex, empty without the reconstructed particles of the event
+    std::pmr::vector<VertexMetrics> vertexMetrics;
+
+    //graph description: drawn particles and the relations between them in drawing order
+    std::pmr::vector<int> nodes;
+    std::pmr::vector< std::pair<int, int> > edges;
+
+    //weakly connected components of the drawn graph, grouped into independent layouts:
+    //large components alone, small ones together, largest first. -1 for particles not drawn
+    int nComponents{};
+    int nLayoutGroups{};
+    std::pmr::vector<int> layoutGroup;
+};
+
+/**
+ * Features of an event used to score it for drawing.
+ */
+struct EventFeatures {
+    int nVertices{};
+    //pairs of vertices whose chains meet below the hadronization
+    int nSharedAncestors{};
+    //tracks whose MC parent differs from the parent of most tracks in their vertex
+    int nWrongVertex{};
+    int nNodes{};
+};
+
+/**
+ * Decay chain analysis of DecayChainDrawer without any framework dependency.
+ * Per event: beginEvent(), analyseMc() once, then per vertex collection
+ * analyseVertices(), describeGraph() and resetVertices().
+ */
+class DecayChainCore {
+    public:
+        explicit DecayChainCore(std::pmr::memory_resource* resource);
+        void clear();
+
+        void beginEvent(const McGraph& graph, EventAnalysis& analysis);
+        //production vertices are classified by analyseMc, the table must outlive the core
+        void setDetectorRegions(const DetectorRegions* regions){_regions = regions;}
+        //hadronization flags, kinematics and detector regions
+        void analyseMc(const McGraph& graph, EventAnalysis& analysis);
+        //vertex decay chains and membership, a particle in several chains belongs to the last vertex.
+        //Vertex metrics in the same pass when the tracks come with the reconstructed particles
+        void analyseVertices(const McGraph& graph, const VertexTracks& tracks, EventAnalysis& analysis);
+        //drawn flags, nodes, edges and layout groups
+        void describeGraph(const McGraph& graph, EventAnalysis& analysis);
+        //membership back to 0 through the chain members only
+        void resetVertices(EventAnalysis& analysis);
+
+        //canonical PDG topology of the decay chain of a vertex
+        uint64_t getTopologyHash(const McGraph& graph, const EventAnalysis& analysis, int vertex);
+        std::string getTopologyLabel(const McGraph& graph, const EventAnalysis& analysis, int vertex);
+        //number of weakly decaying b-hadrons in the chain
+        int countBChains(const McGraph& graph, const EventAnalysis& analysis, int vertex) const;
+
+        EventFeatures getEventFeatures(const McGraph& graph, const VertexTracks& tracks, const EventAnalysis& analysis);
+        //particles of the chain of a vertex with the fraction of the vertex tracks descending from them
+        void getMembershipWeights(const McGraph& graph, const VertexTracks& tracks, int vertex, std::pmr::vector< std::pair<int, float> >& weights);
+
+        //whole graph, or only the nodes and edges of one layout group
+        static void writeDotGraph(const DrawnGraph& graph, const std::map<int, std::string>& pdgNames, const std::vector<std::string>& vtxColors, std::pmr::string& dotGraph, int layoutGroup = -1);
+        static std::map<int, std::string> getPdgNamesMap();
+        //vertex fill colors, one palette per vertex collection
+        static std::vector< std::vector<std::string> > getVertexPalettes();
+        static bool isBHadron(int pdg);
+        static uint64_t mixHash(uint64_t hash);
+
+    private:
+        void fillDecayChainUp(const McGraph& graph, int mc, std::pmr::vector<int>& decayChain);
+        bool isInHadronization(const McGraph& graph, int mc);
+        int findChainRoot(const McGraph& graph, int mc);
+        void countChainUnassigned(const McGraph& graph, const VertexTracks& tracks);
+        VertexMetrics getVertexMetrics(const McGraph& graph, const VertexTracks& tracks, int vertex);
+        void findLayoutGroups(EventAnalysis& analysis);
+        int findRoot(int mc);
+        void markChain(const EventAnalysis& analysis, int vertex);
+        uint64_t getTopologyHash(const McGraph& graph, int mc);
+        std::string getTopologyLabel(const McGraph& graph, int mc);
+
+        std::pmr::memory_resource* _resource;
+        const DetectorRegions* _regions{};
+        //particle i is marked when _marks[i] == _stamp
+        std::pmr::vector<int> _marks;
+        int _stamp{};
+        //0 unknown, 1 in hadronization, 2 not
+        std::pmr::vector<int8_t> _hadronization;
+        //decay chain root of every particle, -1 unknown
+        std::pmr::vector<int> _chainRoots;
+        //reconstructed MC particles per chain root that are in no vertex of the collection
+        std::pmr::vector<int> _chainUnassigned;
+        std::pmr::vector<int> _counts;
+        //union-find parents, then component sizes and groups
+        std::pmr::vector<int> _roots;
+        std::pmr::vector<int> _components;
+
+        //components smaller than this share a layout with other small ones
+        static constexpr int minGroupNodes = 32;
+};
+
+
+#endif
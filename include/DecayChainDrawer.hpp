@@ -4,9 +4,24 @@
 #include "marlin/Processor.h"
 #include "DD4hep/Detector.h"
 #include "UTIL/LCRelationNavigator.h"
-#include "EVENT/MCParticle.h"
-#include "EVENT/Vertex.h"
+#include "AnalysisCache.hpp"
+#include "DecayChainCore.hpp"
+#include "EventArena.hpp"
+#include "GraphRenderer.hpp"
+#include "GraphRing.hpp"
+#include "LcioAdapter.hpp"
+#include "MemoryMonitor.hpp"
+#include "PerfCounters.hpp"
+#include "RegressionGate.hpp"
+#include "ShardIndex.hpp"
+#include "TopologyTable.hpp"
+#include "VertexingHistograms.hpp"
 
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <string_view>
+#include <vector>
 
 
 class DecayChainDrawer : public marlin::Processor {
@@ -15,25 +30,113 @@ class DecayChainDrawer : public marlin::Processor {
         marlin::Processor* newProcessor() {return new DecayChainDrawer;}
         void init();
         void processEvent(LCEvent* event);
-        void end(){};
-
-        void fillDecayChainUp(EVENT::MCParticle* mc, std::vector<EVENT::MCParticle*>& mcs);
-        void fillDecayChainDown(EVENT::MCParticle* mc, std::vector<EVENT::MCParticle*>& mcs);
-        EVENT::MCParticle* getMcMaxTrackWeight(EVENT::ReconstructedParticle* pfo, UTIL::LCRelationNavigator nav);
-        std::vector<EVENT::MCParticle*> getVertexDecayChain(EVENT::Vertex* vertex, UTIL::LCRelationNavigator navRecoToMc);
-        std::map<int, std::string> getPdgNamesMap();
-        
-        bool isInHadronization(EVENT::MCParticle* mc);
-
-        //map of pointer to index in the collection
-        std::map<MCParticle*, int> _p2idx;
-        std::map<MCParticle*, int> _p2vtx;
-        std::map<MCParticle*, bool> _p2hadronization;
-        std::map<MCParticle*, double> _p2distance;
-        std::map<MCParticle*, double> _p2pt;
-        std::map<MCParticle*, double> _p2pz;
+        void end();
+
+        struct SampledGraph {
+            double score;
+            int run;
+            int event;
+            std::string name;
+            std::string dotGraph;
+            std::vector<std::string> groupGraphs;
+        };
+
+        //one analysed vertex collection with its own colors and outputs
+        struct VertexCollection {
+            std::string name{};
+            size_t palette{};
+            std::string vertexMcRelationName{};
+            std::string mcFlagsName{};
+            TopologyTable topologies{};
+            VertexingHistograms vertexing{};
+            std::vector<SampledGraph> sample{};
+            long nSampleCandidates{};
+        };
+
+        void processVertexCollection(LCEvent* event, VertexCollection& collection, const UTIL::LCRelationNavigator& navRecoToMc);
+        void drawVertexCollection(LCEvent* event, VertexCollection& collection, const DrawnGraph& graph, const EventFeatures& features);
+        //false if a vertex collection of the event is not cached, then it is analysed
+        bool drawFromCache(LCEvent* event);
+        void addMembershipCollections(LCEvent* event, const VertexCollection& collection, LCCollection* vertices);
+        void countTopology(VertexCollection& collection, int vertex, LCEvent* event);
+        //radial table of the tracker layers and calorimeters from the DD4hep geometry
+        void buildDetectorRegions();
+        //stage boundaries for the memory monitor and the hardware counters
+        void beginStage(ProcessingStage stage);
+        void endStage(ProcessingStage stage);
+
+        //groupGraphs: one graph per layout group for the parallel layout, empty to lay out dotGraph as one
+        void writeGraph(const std::string& graphName, std::string_view dotGraph, const std::vector<std::string>& groupGraphs, const std::string& collectionName, int run, int event);
+        //writeGraph without the viewer: .dot file, layout and shard index
+        void renderGraph(const std::string& graphName, std::string_view dotGraph, const std::vector<std::string>& groupGraphs, const std::string& collectionName, int run, int event);
+        //empty unless the renderer lays out groups in parallel and the graph has several
+        std::vector<std::string> getGroupGraphs(const DrawnGraph& graph, const VertexCollection& collection);
+
+        //event sampling for drawing
+        enum class Sampling {all, reservoir, topK};
+        double getEventScore(const EventFeatures& features);
+        //slot in the sample for the event, -1 if it is not sampled
+        int getSampleSlot(VertexCollection& collection, double score);
+        void addSample(VertexCollection& collection, int slot, SampledGraph graph);
+
+
+        //per-event temporaries are allocated here and dropped at the start of the next event
+        EventArena _arena{};
+        int _arenaSize{};
+
+        //LCIO view, analysis state and results of the current event
+        LcioAdapter _adapter{&_arena};
+        DecayChainCore _core{&_arena};
+        EventAnalysis _analysis{&_arena};
+        bool _mcAnalysed{};
+        bool _mcCached{};
         std::map<int, std::string> _pdg2str;
-        std::vector <std::string> _vtxColors = {"yellow", "yellow4", "yellowgreen", "orange", "orange4", "lightpink", "lightcoral", "lightcyan", "lightslateblue", "lightseagreen"};
+        bool _annotateRegions{};
+        DetectorRegions _detectorRegions{};
+        //vertex colors, one palette per vertex collection
+        std::vector< std::vector<std::string> > _vtxPalettes = DecayChainCore::getVertexPalettes();
+
+        std::vector<std::string> _vertexCollectionNames{};
+        std::vector<VertexCollection> _vertexCollections{};
+        bool _writeMembership{};
+        std::string _vertexMcRelationName{};
+        std::string _mcFlagsName{};
+
+        std::string _outputDirectory{};
+        std::string _shardName{};
+        bool _openViewer{};
+        float _renderTimeout{};
+        int _layoutThreads{};
+        GraphRenderer _renderer{};
+        std::string _viewerRing{};
+        GraphRing _ring{};
+        bool _drawGraphs{};
+        bool _countTopologies{};
+        bool _vertexingMetrics{};
+
+        std::string _samplingMode{};
+        Sampling _sampling{};
+        int _sampleSize{};
+        int _samplingSeed{};
+        std::vector<float> _scoreWeights{};
+        std::mt19937 _random{};
+
+        bool _memoryAccounting{};
+        MemoryMonitor _memory{};
+        bool _perfCounters{};
+        PerfCounters _perf{};
+
+        std::string _goldenMode{};
+        std::string _goldenDirectory{};
+        float _budgetMargin{};
+        RegressionGate _gate{};
+        ShardIndex _shardIndex{};
+
+        std::string _cacheDirectory{};
+        AnalysisCache _cache{};
+        //lookup buffers of drawFromCache, reused across events
+        std::vector<std::string> _cachedNames{};
+        std::vector<AnalysisCache::VertexRecord> _cachedVertices{};
 
         int _nEvent{};
 };
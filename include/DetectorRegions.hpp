@@ -0,0 +1,44 @@
+#ifndef DetectorRegions_h
+#define DetectorRegions_h 1
+
+#include <string>
+#include <vector>
+
+/**
+ * Detector region of a production vertex from a radial table built once from the geometry.
+ * A barrel region reaches from its inner radius to the inner radius of the next one
+ * and over |z| < zHalf, vertices beyond zHalf are in the forward region.
+ * The beam pipe below the innermost region has no z limit.
+ * Lookup is a branchless binary search over squared radii padded to a power of two.
+ * Lengths in mm.
+ */
+class DetectorRegions {
+    public:
+        void add(const std::string& name, double rMin, double zHalf);
+        //sorts the regions and builds the search table, regions below the innermost one are "beam pipe"
+        void finish();
+        bool empty() const {return _names.empty();}
+
+        //region index of each position
+        void classify(const double* x, const double* y, const double* z, int n, int* region) const;
+        const std::string& name(int region) const {return _names[region];}
+        int size() const {return _names.size();}
+
+    private:
+        struct Region {
+            std::string name;
+            double rMin;
+            double zHalf;
+        };
+        std::vector<Region> _regions{};
+
+        //names of the barrel regions, then forward
+        std::vector<std::string> _names{};
+        //table of 2^n squared inner radii, padded with infinity
+        std::vector<double> _r2Min{};
+        std::vector<double> _zHalf{};
+        int _forward{};
+};
+
+
+#endif
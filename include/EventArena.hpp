@@ -0,0 +1,38 @@
+#ifndef EventArena_h
+#define EventArena_h 1
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * Monotonic memory resource for the per-event temporaries of the processor.
+ * Deallocation is a no-op, everything is dropped at once with reset().
+ * When an event overflows the preallocated buffer, the buffer is grown to the
+ * high-water mark on the next reset(), so steady state events never touch the heap.
+ */
+class EventArena : public std::pmr::memory_resource {
+    public:
+        explicit EventArena(std::size_t size = 1 << 20);
+
+        void reserve(std::size_t size);
+        void reset();
+
+        std::size_t used() const {return _used;}
+        std::size_t peak() const {return _peak;}
+        std::size_t capacity() const {return _buffer.size();}
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void*, std::size_t, std::size_t) override {}
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {return this == &other;}
+
+        std::vector<std::byte> _buffer;
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> _resource;
+        std::size_t _used{};
+        std::size_t _peak{};
+};
+
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef GraphRenderer_h
+#define GraphRenderer_h 1
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * Renders DOT files to SVG with dot in child processes under one time budget per graph.
+ * The full layout may use half of the budget, if it is killed there it is retried with a
+ * reduced layout (no crossing minimisation, straight edges) in the rest.
+ * If that also times out only the plain .dot file is kept.
+ * Graphs given as several layout groups are laid out concurrently, one dot per group
+ * waited on by up to nThreads threads started for that graph, within three quarters of
+ * the budget, and packed into one canvas with gvpack and neato -n2 in the rest.
+ */
+class GraphRenderer {
+    public:
+        enum class Result {rendered, reduced, plainDot, failed};
+
+        //timeout in seconds per graph, 0 for no limit. nThreads 0: all cores, 1: no parallel layout
+        void setup(double timeout, int nThreads);
+        bool isParallel() const {return _nThreads > 1;}
+        //renders <graphPath>.dot to <graphPath>.svg, in parallel if more than one layout group is given
+        Result render(const std::string& graphPath, const std::vector<std::string>& groupGraphs = {});
+
+        void print(std::ostream& report) const;
+        long nTimeouts() const {return _nReduced + _nPlainDot;}
+
+    private:
+        using Deadline = std::chrono::steady_clock::time_point;
+
+        //full layout, then reduced layout, all before deadline
+        Result renderWhole(const std::string& graphPath, Deadline deadline);
+        //failed if the groups or the packing could not be done, then the whole graph is rendered
+        Result renderGroups(const std::string& graphPath, const std::vector<std::string>& groupGraphs, Deadline deadline);
+        //dot to outputPath, retried with the reduced layout if the first half of the time left is not enough
+        int layout(const std::string& format, const std::string& dotPath, const std::string& outputPath, Deadline deadline, bool& reduced);
+        //exit status of the command with stdout to outputPath, -1 if it was killed at the deadline
+        int run(const std::vector<std::string>& args, const std::string& outputPath, Deadline deadline);
+
+        double _timeout{};
+        int _nThreads{};
+        long _nParallel{};
+        long _nRendered{};
+        long _nReduced{};
+        long _nPlainDot{};
+        long _nFailed{};
+        double _maxSeconds{};
+};
+
+
+#endif
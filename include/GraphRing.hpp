@@ -0,0 +1,53 @@
+#ifndef GraphRing_h
+#define GraphRing_h 1
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * Single-producer single-consumer ring of DOT graphs in POSIX shared memory.
+ * DecayChainViewer creates the ring and consumes it, the processor opens it and publishes.
+ * Publishing does not block beyond the given wait: with the ring still full, a graph whose name
+ * and text exceed a slot or the viewer gone it returns false and the caller falls back to writing files.
+ */
+class GraphRing {
+    public:
+        GraphRing() = default;
+        GraphRing(const GraphRing&) = delete;
+        GraphRing& operator=(const GraphRing&) = delete;
+        ~GraphRing();
+
+        //creates the ring /name, replacing a stale one
+        bool create(const std::string& name, int nSlots, size_t slotSize);
+        //opens a ring created by a running viewer
+        bool open(const std::string& name);
+        bool isOpen() const {return _header != nullptr;}
+
+        //waits up to wait seconds for a free slot while the viewer is alive
+        bool publish(std::string_view graphName, int run, int event, std::string_view dotGraph, double wait = 0.);
+        //oldest graph of the ring, false if it is empty
+        bool consume(std::string& graphName, int& run, int& event, std::string& dotGraph);
+        //no graph waiting to be consumed
+        bool empty() const;
+
+        long nPublished() const {return _nPublished;}
+        long nRejected() const {return _nRejected;}
+
+    private:
+        struct Header;
+        struct Slot;
+        Slot* slot(uint64_t i) const;
+        void close();
+
+        std::string _name{};
+        bool _owner{};
+        Header* _header{};
+        size_t _size{};
+        long _nPublished{};
+        long _nRejected{};
+};
+
+
+#endif
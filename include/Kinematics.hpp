@@ -0,0 +1,43 @@
+#ifndef Kinematics_h
+#define Kinematics_h 1
+
+#include "McGraph.hpp"
+
+#include <memory_resource>
+
+/**
+ * Per-particle kinematics of one event as structure of arrays.
+ * Inputs are the coordinate arrays of the McGraph, used in place, the outputs are
+ * computed by branch-free loops over aligned arrays that the compiler vectorizes.
+ * Outputs live in the given memory resource, the per-event arena in the processor.
+ */
+struct Kinematics {
+    static constexpr std::size_t alignment = 64;
+
+    //points the inputs to the graph and allocates the outputs
+    void allocate(std::pmr::memory_resource* resource, const McGraph& graph);
+    //distance, pt and decay length of all particles, ip is the interaction point
+    void compute(const double* ip);
+    //pseudorapidity of all particles, a separate loop as log does not vectorize without fast-math
+    void computeEta();
+
+    int n{};
+    // inputs
+    const double* vx{};
+    const double* vy{};
+    const double* vz{};
+    const double* ex{};
+    const double* ey{};
+    const double* ez{};
+    const double* px{};
+    const double* py{};
+    const double* pz{};
+    // outputs
+    double* distance{};
+    double* pt{};
+    double* decayLength{};
+    double* eta{};
+};
+
+
+#endif
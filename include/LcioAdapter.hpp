@@ -0,0 +1,58 @@
+#ifndef LcioAdapter_h
+#define LcioAdapter_h 1
+
+#include "McGraph.hpp"
+
+#include "EVENT/LCCollection.h"
+#include "EVENT/MCParticle.h"
+#include "EVENT/ReconstructedParticle.h"
+#include "UTIL/LCRelationNavigator.h"
+
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Fills the index arrays of McGraph and VertexTracks from LCIO collections.
+ * Only depends on LCIO, so it is shared by the Marlin processor and the standalone tools.
+ * Arrays live in the given memory resource and must be cleared before it is released.
+ */
+class LcioAdapter {
+    public:
+        explicit LcioAdapter(std::pmr::memory_resource* resource);
+        void clear();
+
+        const McGraph& setMcParticles(EVENT::LCCollection* mcCol);
+        const VertexTracks& setVertices(EVENT::LCCollection* vertices, const UTIL::LCRelationNavigator& navRecoToMc);
+        //charged particles of the reco to MC links for the vertex metrics, kept for all vertex collections of the event
+        const VertexTracks& setReconstructedParticles(EVENT::LCCollection* recoMcLinks, const UTIL::LCRelationNavigator& navRecoToMc);
+
+        const McGraph& graph() const {return _graph;}
+        const VertexTracks& tracks() const {return _tracks;}
+        EVENT::MCParticle* mcParticle(int i) const {return _particles[i];}
+        //-1 if the particle is not in the MC collection
+        int index(EVENT::MCParticle* mc) const;
+
+        static EVENT::MCParticle* getMcMaxTrackWeight(EVENT::ReconstructedParticle* pfo, const UTIL::LCRelationNavigator& nav);
+
+    private:
+        //coordinate arrays of the McGraph are allocated here directly
+        std::pmr::memory_resource* _resource;
+        std::pmr::vector<EVENT::MCParticle*> _particles;
+        std::pmr::unordered_map<EVENT::MCParticle*, int> _index;
+        std::pmr::vector<int> _pdg;
+        std::pmr::vector<int> _generatorStatus;
+        std::pmr::vector<int> _parentOffsets;
+        std::pmr::vector<int> _parents;
+        std::pmr::vector<int> _daughterOffsets;
+        std::pmr::vector<int> _daughters;
+        std::pmr::vector<int> _trackOffsets;
+        std::pmr::vector<int> _trackMc;
+        std::pmr::vector<int> _reconstructedMc;
+
+        McGraph _graph{};
+        VertexTracks _tracks{};
+};
+
+
+#endif
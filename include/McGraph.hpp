@@ -0,0 +1,50 @@
+#ifndef McGraph_h
+#define McGraph_h 1
+
+/**
+ * Input of DecayChainCore as plain index arrays, independent of LCIO.
+ * Particles are referred to by their index in the MC collection.
+ * Parents and daughters are in CSR form: the parents of particle i are
+ * parents[parentOffsets[i]] ... parents[parentOffsets[i+1]-1].
+ * Production vertex, endpoint and momentum are one array per coordinate, gathered
+ * once and read in place by the kinematics kernel.
+ * The arrays are not owned, see LcioAdapter for filling them from an LCEvent.
+ */
+struct McGraph {
+    int nParticles{};
+    const int* pdg{};
+    const int* generatorStatus{};
+    const int* parentOffsets{};
+    const int* parents{};
+    const int* daughterOffsets{};
+    const int* daughters{};
+    const double* vx{};
+    const double* vy{};
+    const double* vz{};
+    const double* ex{};
+    const double* ey{};
+    const double* ez{};
+    const double* px{};
+    const double* py{};
+    const double* pz{};
+};
+
+/**
+ * Vertex to track to MC links of one vertex collection.
+ * Tracks of vertex j are trackMc[trackOffsets[j]] ... trackMc[trackOffsets[j+1]-1],
+ * each holding the index of the MC particle with the highest track weight, -1 if none.
+ * The charged reconstructed particles of the whole event are given in the same form for
+ * the vertex metrics, which are not computed without them.
+ */
+struct VertexTracks {
+    int nVertices{};
+    const int* trackOffsets{};
+    const int* trackMc{};
+    //set even for an event without any charged reconstructed particle
+    bool hasReconstructed{};
+    int nReconstructed{};
+    const int* reconstructedMc{};
+};
+
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef MemoryMonitor_h
+#define MemoryMonitor_h 1
+
+#include "ProcessingStage.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+
+/**
+ * Heap allocations per event and per processing stage plus resident memory.
+ * Allocation counts come from the DecayChainAllocCounter library which replaces
+ * the global operator new and has to be preloaded:
+ *     LD_PRELOAD=libDecayChainAllocCounter.so Marlin steer.xml
+ * Without it only the resident memory is monitored.
+ * Distributions are kept in log2 histograms, so memory use does not grow with the job.
+ */
+class MemoryMonitor {
+    public:
+        //all calls are no-ops until enabled
+        void enable();
+        bool isEnabled() const {return _enabled;}
+        bool hasAllocationCounts() const {return _counts != nullptr;}
+        uint64_t totalAllocations() const {return _allocationsPerEvent.sum;}
+
+        void beginEvent();
+        void beginStage(ProcessingStage stage);
+        void endStage(ProcessingStage stage);
+        void endEvent();
+
+        void print(std::ostream& out) const;
+
+        //ends the event on any path out of processEvent
+        struct EventScope {
+            explicit EventScope(MemoryMonitor& monitor) : _monitor(monitor) {_monitor.beginEvent();}
+            ~EventScope(){_monitor.endEvent();}
+            MemoryMonitor& _monitor;
+        };
+
+    private:
+        //log2 histogram with running sum and maximum
+        struct Distribution {
+            void fill(uint64_t value);
+            uint64_t quantile(double fraction) const;
+            std::array<uint64_t, 65> bins{};
+            uint64_t n{};
+            double sum{};
+            uint64_t max{};
+        };
+        static void printDistribution(std::ostream& out, const char* name, const Distribution& distribution, const char* unit);
+
+        void readCounts(uint64_t& nAllocations, uint64_t& nBytes) const;
+        static uint64_t getRss();
+        static uint64_t getPeakRss();
+
+        bool _enabled{};
+        void (*_counts)(unsigned long*, unsigned long*){};
+        uint64_t _eventStartAllocations{};
+        uint64_t _eventStartBytes{};
+        uint64_t _stageStartAllocations{};
+        uint64_t _stageStartBytes{};
+
+        std::array<uint64_t, nProcessingStages> _stageAllocations{};
+        std::array<uint64_t, nProcessingStages> _stageBytes{};
+
+        Distribution _allocationsPerEvent{};
+        Distribution _bytesPerEvent{};
+        Distribution _rss{};
+        std::array<Distribution, nProcessingStages> _allocationsPerStage{};
+        std::array<Distribution, nProcessingStages> _bytesPerStage{};
+};
+
+
+#endif
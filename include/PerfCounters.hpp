@@ -0,0 +1,46 @@
+#ifndef PerfCounters_h
+#define PerfCounters_h 1
+
+#include "ProcessingStage.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+
+/**
+ * Hardware counters of the processing stages read with perf_event_open:
+ * cycles, instructions, cache misses and branch misses of this thread in user space.
+ * Counters that cannot be opened, e.g. in containers or with perf_event_paranoid > 2,
+ * are reported as unavailable. Without any counter all calls are no-ops.
+ * Values are scaled by enabled / running time when the kernel multiplexes counters.
+ */
+class PerfCounters {
+    public:
+        enum Counter {cycles, instructions, cacheMisses, branchMisses, nCounters};
+
+        PerfCounters() = default;
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+        ~PerfCounters();
+
+        //returns the number of counters that could be opened
+        int enable();
+        bool isEnabled() const {return _enabled;}
+
+        void beginStage(ProcessingStage stage);
+        void endStage(ProcessingStage stage);
+
+        void print(std::ostream& out) const;
+
+    private:
+        void read(std::array<double, nCounters>& values) const;
+
+        bool _enabled{};
+        std::array<int, nCounters> _fds{-1, -1, -1, -1};
+        std::array<double, nCounters> _stageStart{};
+        std::array<long, nProcessingStages> _nCalls{};
+        std::array< std::array<double, nCounters>, nProcessingStages > _stageTotals{};
+};
+
+
+#endif
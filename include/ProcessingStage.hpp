@@ -0,0 +1,13 @@
+#ifndef ProcessingStage_h
+#define ProcessingStage_h 1
+
+/**
+ * Stages of DecayChainDrawer::processEvent used by the job instrumentation.
+ */
+enum class ProcessingStage {chains, maps, sampling, graph, render, nStages};
+
+constexpr int nProcessingStages = int(ProcessingStage::nStages);
+constexpr const char* processingStageNames[nProcessingStages] = {"vertex chains", "particle maps", "sampling", "graph text", "render"};
+
+
+#endif
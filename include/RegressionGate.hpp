@@ -0,0 +1,58 @@
+#ifndef RegressionGate_h
+#define RegressionGate_h 1
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+/**
+ * Golden-event regression gate of the processor.
+ * In record mode the graph text of every event and the per-event budgets
+ * (wall time, heap allocations) are written to the golden directory.
+ * In compare mode the graph text must match the golden files exactly and the
+ * measured averages must stay within the recorded budgets times (1 + margin),
+ * and every golden graph must be produced again. A measured quantity without a
+ * recorded budget fails the gate.
+ */
+class RegressionGate {
+    public:
+        enum class Mode {off, record, compare};
+
+        void setup(Mode mode, const std::string& directory, double margin);
+        Mode mode() const {return _mode;}
+
+        void checkGraph(const std::string& collection, int run, int event, std::string_view dotGraph);
+        void addEvent(double seconds);
+
+        //measures the wall time of processEvent on any path out of it
+        struct EventTimer {
+            explicit EventTimer(RegressionGate& gate) : _gate(gate), _start(std::chrono::steady_clock::now()) {}
+            ~EventTimer(){_gate.addEvent( std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count() );}
+            RegressionGate& _gate;
+            std::chrono::steady_clock::time_point _start;
+        };
+
+        //allocations are only checked when hasAllocations, returns false if the gate failed
+        bool finish(bool hasAllocations, uint64_t nAllocations, std::ostream& report);
+
+    private:
+        static std::string goldenName(const std::string& collection, int run, int event);
+
+        Mode _mode{};
+        std::string _directory{};
+        double _margin{};
+
+        long _nEvents{};
+        double _seconds{};
+        long _nGraphs{};
+        long _nMismatches{};
+        long _nMissing{};
+        //golden file names of the graphs of this run
+        std::unordered_set<std::string> _produced{};
+};
+
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef ShardIndex_h
+#define ShardIndex_h 1
+
+#include <array>
+#include <string>
+#include <vector>
+
+/**
+ * Self-describing index of the graphs written by one job (a shard).
+ * It records the input files with their (run, event) range and ties every graph
+ * to the input it came from, so shards of many grid jobs can be merged into one
+ * global index by DecayChainMerge without touching the graph files themselves.
+ */
+struct ShardInput {
+    std::string path;
+    //first and last (run, event) of the file in reading order, -1 if unknown
+    int firstRun{-1};
+    int firstEvent{-1};
+    int lastRun{-1};
+    int lastEvent{-1};
+};
+
+struct ShardEntry {
+    int run;
+    int event;
+    //index in ShardIndex::inputs, -1 if unknown
+    int input;
+    std::string collection;
+    std::string file;
+};
+
+class ShardIndex {
+    public:
+        //input file with the run and event numbers of its events as pairs, from LCReader::getEvents
+        void addInput(const std::string& path, const std::vector<int>& runEvents);
+        //the input of the graph is looked up from its (run, event)
+        void add(int run, int event, const std::string& collection, const std::string& file);
+        void merge(const ShardIndex& other);
+        void sort();
+        //returns number of (run, event, collection) found more than once, after sort()
+        int countDuplicates() const;
+
+        bool write(const std::string& path) const;
+        //graph file paths are resolved to absolute paths relative to the index location
+        bool read(const std::string& path);
+
+        std::string name;
+        std::vector<ShardInput> inputs;
+        std::vector<ShardEntry> entries;
+
+    private:
+        int findInput(int run, int event) const;
+
+        //run, event, input of every event of the inputs, sorted
+        std::vector< std::array<int, 3> > _inputEvents{};
+};
+
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef TopologyTable_h
+#define TopologyTable_h 1
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Counts of canonical decay chain topologies accumulated over events.
+ * Open addressing hash table with linear probing keyed by the 64 bit topology hash.
+ * The readable label of a topology is only built when it is seen for the first time.
+ */
+class TopologyTable {
+    public:
+        static constexpr int nExamples = 5;
+
+        struct Entry {
+            uint64_t hash;
+            long count;
+            int nBChains;
+            int label;
+            int nStoredExamples;
+            std::array<std::pair<int, int>, nExamples> examples;
+        };
+
+        explicit TopologyTable(size_t capacity = 1024);
+
+        //returns entry of the hash, label is left -1 for a new entry
+        Entry& find(uint64_t hash);
+        void add(Entry& entry, int run, int event);
+        void setLabel(Entry& entry, const std::string& label);
+
+        //ranked by count, most frequent first
+        std::vector<const Entry*> ranked() const;
+        const std::string& label(const Entry& entry) const {return _labels[entry.label];}
+        size_t size() const {return _size;}
+        long total() const {return _total;}
+
+        bool write(const std::string& path) const;
+
+    private:
+        void grow();
+
+        std::vector<Entry> _slots;
+        std::vector<std::string> _labels;
+        size_t _size{};
+        long _total{};
+};
+
+
+#endif
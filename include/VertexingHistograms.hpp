@@ -0,0 +1,50 @@
+#ifndef VertexingHistograms_h
+#define VertexingHistograms_h 1
+
+#include "DecayChainCore.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+/**
+ * Truth quality of the reconstructed vertices of one vertex collection accumulated over events:
+ * purity (tracks of the dominant decay chain / tracks), efficiency (found / found + missed
+ * particles of the dominant chain), decay chains merged into a vertex and missed tracks.
+ * Owned by one processor instance and filled from its processEvent only.
+ */
+class VertexingHistograms {
+    public:
+        static constexpr int nFractionBins = 20;
+        //0 ... nCountBins-2, the last bin holds everything above
+        static constexpr int nCountBins = 21;
+
+        void fill(const VertexMetrics* metrics, int n);
+
+        long nVertices() const {return _nVertices;}
+        //pooled over all vertices
+        double purity() const;
+        double efficiency() const;
+        //fraction of vertices with tracks from more than one decay chain
+        double mergedFraction() const;
+
+        bool write(const std::string& path) const;
+        void print(std::ostream& out) const;
+
+    private:
+        std::array<uint64_t, nFractionBins> _purity{};
+        std::array<uint64_t, nFractionBins> _efficiency{};
+        std::array<uint64_t, nCountBins> _chains{};
+        std::array<uint64_t, nCountBins> _missed{};
+
+        uint64_t _nVertices{};
+        uint64_t _nMerged{};
+        uint64_t _nTracks{};
+        uint64_t _nDominant{};
+        uint64_t _nFound{};
+        uint64_t _nMissed{};
+};
+
+
+#endif
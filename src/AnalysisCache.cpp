@@ -0,0 +1,312 @@
+#include "AnalysisCache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    constexpr char magic[8] = {'D', 'C', 'C', 'A', 'C', 'H', 'E', '\0'};
+    constexpr uint32_t version = 3;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t nRecords;
+        uint64_t inputIdentity;
+        //0 while the file is written
+        uint64_t indexOffset;
+    };
+
+    struct McHeader {
+        int32_t nParticles;
+        int32_t nDaughters;
+        int32_t hasRegion;
+        int32_t reserved;
+    };
+
+    struct VertexHeader {
+        int32_t nParticles;
+        int32_t reserved;
+        EventFeatures features;
+    };
+
+    // key of the MC record of an event, no vertex collection has an empty name
+    const std::string mcRecordName = "";
+
+    bool byKey(const AnalysisCache::IndexEntry& a, const AnalysisCache::IndexEntry& b){
+        if (a.run != b.run) return a.run < b.run;
+        if (a.event != b.event) return a.event < b.event;
+        return a.collection < b.collection;
+    }
+
+    size_t padded(size_t size){return (size + 7) & ~size_t(7);}
+
+    template <typename T>
+    void writeArray(std::ofstream& file, const T* data, int n){
+        size_t size = n*sizeof(T);
+        file.write(reinterpret_cast<const char*>(data), size);
+        static const char zeros[8] = {};
+        file.write(zeros, padded(size) - size);
+    }
+
+    //reads consecutive blocks of a record, a block past end leaves ok false and returns null
+    struct RecordReader {
+        const char* data;
+        const char* end;
+        bool ok{true};
+
+        template <typename T>
+        const T* read(long n){
+            if ( !ok || n < 0 || padded(n*sizeof(T)) > size_t(end - data) ){
+                ok = false;
+                return nullptr;
+            }
+            const T* array = reinterpret_cast<const T*>(data);
+            data += padded(n*sizeof(T));
+            return array;
+        }
+    };
+
+    //daughters in CSR form within the n particles
+    bool isValidGraph(const McGraph& graph, int nDaughters){
+        int n = graph.nParticles;
+        if (graph.daughterOffsets[0] != 0 || graph.daughterOffsets[n] != nDaughters) return false;
+        for(int i=0; i<n; ++i){
+            if (graph.daughterOffsets[i] > graph.daughterOffsets[i+1]) return false;
+        }
+        for(int d=0; d<nDaughters; ++d){
+            if (graph.daughters[d] < 0 || graph.daughters[d] >= n) return false;
+        }
+        return true;
+    }
+}
+
+
+AnalysisCache::~AnalysisCache(){
+    unmap();
+}
+
+
+void AnalysisCache::open(const std::string& path, const std::vector<std::string>& inputFiles){
+    _path = path;
+    _identity = getInputIdentity(inputFiles);
+    if ( map(path, _identity) ){
+        _mode = Mode::read;
+        return;
+    }
+
+    // placeholder header, completed by close()
+    _mode = Mode::write;
+    _index.clear();
+    _file.open(_path + ".tmp", std::ios::binary | std::ios::trunc);
+    FileHeader header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.inputIdentity = _identity;
+    _file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+
+bool AnalysisCache::map(const std::string& path, uint64_t identity){
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat status;
+    if (fstat(fd, &status) != 0 || size_t(status.st_size) < sizeof(FileHeader)){
+        ::close(fd);
+        return false;
+    }
+    _size = status.st_size;
+    void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) return false;
+    _data = static_cast<const char*>(data);
+
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(_data);
+    bool valid = std::memcmp(header->magic, magic, sizeof(magic)) == 0 && header->version == version && header->inputIdentity == identity
+                 && header->indexOffset >= sizeof(FileHeader) && header->indexOffset + header->nRecords*sizeof(IndexEntry) <= _size;
+    if ( !valid ){
+        unmap();
+        return false;
+    }
+    _entries = reinterpret_cast<const IndexEntry*>(_data + header->indexOffset);
+    _recordsEnd = _data + header->indexOffset;
+    _nRecords = header->nRecords;
+    return true;
+}
+
+
+void AnalysisCache::unmap(){
+    if (_data != nullptr) munmap( const_cast<char*>(_data), _size );
+    _data = nullptr;
+    _size = 0;
+    _entries = nullptr;
+    _recordsEnd = nullptr;
+    _nRecords = 0;
+}
+
+
+const char* AnalysisCache::findRecord(int run, int event, uint64_t collection) const{
+    IndexEntry key{run, event, collection, 0};
+    const IndexEntry* entry = std::lower_bound(_entries, _entries + _nRecords, key, byKey);
+    if (entry == _entries + _nRecords || byKey(key, *entry) ) return nullptr;
+    // records lie between the file header and the index, 8-byte aligned
+    if (entry->offset < sizeof(FileHeader) || entry->offset % 8 != 0 || entry->offset >= uint64_t(_recordsEnd - _data)) return nullptr;
+    return _data + entry->offset;
+}
+
+
+bool AnalysisCache::find(int run, int event, const std::vector<std::string>& collections, McRecord& mc, std::vector<VertexRecord>& vertices){
+    if (_mode != Mode::read) return false;
+    // a truncated or corrupt record counts as a miss and the event is analysed again
+    if ( !readMc(run, event, mc) || !readVertices(run, event, collections, mc.graph.nParticles, vertices) ){
+        ++_nMisses;
+        return false;
+    }
+    ++_nHits;
+    return true;
+}
+
+
+bool AnalysisCache::readMc(int run, int event, McRecord& mc) const{
+    const char* data = findRecord(run, event, getNameHash(mcRecordName));
+    if (data == nullptr) return false;
+    RecordReader reader{data, _recordsEnd};
+    const McHeader* header = reader.read<McHeader>(1);
+    if (header == nullptr || header->nParticles < 0 || header->nDaughters < 0) return false;
+    int n = header->nParticles;
+    mc.graph = McGraph{};
+    mc.graph.nParticles = n;
+    mc.graph.pdg = reader.read<int>(n);
+    mc.graph.generatorStatus = reader.read<int>(n);
+    mc.graph.daughterOffsets = reader.read<int>(long(n) + 1);
+    mc.graph.daughters = reader.read<int>(header->nDaughters);
+    mc.flags = reader.read<uint8_t>(n);
+    mc.distance = reader.read<double>(n);
+    mc.pt = reader.read<double>(n);
+    mc.pz = reader.read<double>(n);
+    mc.decayLength = reader.read<double>(n);
+    mc.eta = reader.read<double>(n);
+    // region names come from the geometry of this job
+    mc.region = header->hasRegion ? reader.read<int>(n) : nullptr;
+    return reader.ok && isValidGraph(mc.graph, header->nDaughters);
+}
+
+
+bool AnalysisCache::readVertices(int run, int event, const std::vector<std::string>& collections, int nParticles, std::vector<VertexRecord>& vertices) const{
+    vertices.resize( collections.size() );
+    for(size_t i=0; i<collections.size(); ++i){
+        const char* data = findRecord(run, event, getNameHash(collections[i]));
+        if (data == nullptr) return false;
+        RecordReader reader{data, _recordsEnd};
+        const VertexHeader* header = reader.read<VertexHeader>(1);
+        // membership is indexed by the particles of the MC record
+        if (header == nullptr || header->nParticles != nParticles) return false;
+        vertices[i].features = header->features;
+        vertices[i].vertex = reader.read<int>(nParticles);
+        if ( !reader.ok ) return false;
+    }
+    return true;
+}
+
+
+void AnalysisCache::addMc(int run, int event, const McGraph& graph, const EventAnalysis& analysis){
+    if (_mode != Mode::write) return;
+    _index.push_back({run, event, getNameHash(mcRecordName), uint64_t(_file.tellp())});
+
+    int n = graph.nParticles;
+    bool hasRegion = analysis.regions != nullptr;
+    McHeader header{n, graph.daughterOffsets[n], hasRegion, 0};
+    writeArray(_file, &header, 1);
+    writeArray(_file, graph.pdg, n);
+    writeArray(_file, graph.generatorStatus, n);
+    writeArray(_file, graph.daughterOffsets, n+1);
+    writeArray(_file, graph.daughters, graph.daughterOffsets[n]);
+    // drawn depends on the drawing options and is redone on reload
+    _flags.assign(analysis.flags.begin(), analysis.flags.end());
+    for(auto& flag : _flags) flag &= ~EventAnalysis::drawn;
+    writeArray(_file, _flags.data(), n);
+    const Kinematics& kinematics = analysis.kinematics;
+    writeArray(_file, kinematics.distance, n);
+    writeArray(_file, kinematics.pt, n);
+    writeArray(_file, kinematics.pz, n);
+    writeArray(_file, kinematics.decayLength, n);
+    writeArray(_file, kinematics.eta, n);
+    if (hasRegion) writeArray(_file, analysis.region.data(), n);
+}
+
+
+void AnalysisCache::addVertices(int run, int event, const std::string& collection, const EventAnalysis& analysis, const EventFeatures& features){
+    if (_mode != Mode::write) return;
+    _index.push_back({run, event, getNameHash(collection), uint64_t(_file.tellp())});
+
+    VertexHeader header{analysis.nParticles, 0, features};
+    writeArray(_file, &header, 1);
+    writeArray(_file, analysis.vertex.data(), analysis.nParticles);
+}
+
+
+bool AnalysisCache::close(){
+    if (_mode != Mode::write) return true;
+    _mode = Mode::off;
+
+    // records of a (run, event) found in several inputs keep their order, lookups use the first
+    std::stable_sort(_index.begin(), _index.end(), byKey);
+    _nDuplicates = 0;
+    for(size_t i=1; i<_index.size(); ++i){
+        const IndexEntry& a = _index[i-1];
+        const IndexEntry& b = _index[i];
+        if (a.run == b.run && a.event == b.event && a.collection == b.collection) ++_nDuplicates;
+    }
+    uint64_t indexOffset = _file.tellp();
+    writeArray(_file, _index.data(), _index.size());
+
+    FileHeader header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.nRecords = _index.size();
+    header.inputIdentity = _identity;
+    header.indexOffset = indexOffset;
+    _file.seekp(0);
+    _file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    _file.close();
+    if ( !_file ) return false;
+
+    std::error_code error;
+    std::filesystem::rename(_path + ".tmp", _path, error);
+    return !error;
+}
+
+
+uint64_t AnalysisCache::getInputIdentity(const std::vector<std::string>& inputFiles){
+    uint64_t identity = getNameHash("");
+    for(auto& file : inputFiles){
+        std::error_code error;
+        std::filesystem::path path = std::filesystem::absolute(file, error).lexically_normal();
+        uint64_t size = std::filesystem::file_size(path, error);
+        uint64_t time = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+        identity = DecayChainCore::mixHash(identity ^ getNameHash( path.string() ));
+        identity = DecayChainCore::mixHash(identity ^ size);
+        identity = DecayChainCore::mixHash(identity ^ time);
+    }
+    return identity;
+}
+
+
+uint64_t AnalysisCache::getNameHash(const std::string& name){
+    // FNV-1a, stable across runs and compilers unlike std::hash
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for(unsigned char c : name){
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
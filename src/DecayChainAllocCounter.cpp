@@ -0,0 +1,74 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/**
+ * Replacement of the global operator new counting heap allocations of the whole process.
+ * Preload it to get allocation counts from the MemoryAccounting of DecayChainDrawer:
+ *     LD_PRELOAD=libDecayChainAllocCounter.so Marlin steer.xml
+ */
+
+namespace {
+    std::atomic<unsigned long> nAllocations{0};
+    std::atomic<unsigned long> nBytes{0};
+
+    void* countedAllocation(std::size_t size){
+        nAllocations.fetch_add(1, std::memory_order_relaxed);
+        nBytes.fetch_add(size, std::memory_order_relaxed);
+        if (size == 0) size = 1;
+        void* p = std::malloc(size);
+        if ( !p ) throw std::bad_alloc();
+        return p;
+    }
+
+    void* countedAlignedAllocation(std::size_t size, std::align_val_t alignment){
+        nAllocations.fetch_add(1, std::memory_order_relaxed);
+        nBytes.fetch_add(size, std::memory_order_relaxed);
+        std::size_t align = static_cast<std::size_t>(alignment);
+        // aligned_alloc wants a multiple of the alignment
+        size = (size + align - 1) / align * align;
+        if (size == 0) size = align;
+        void* p = std::aligned_alloc(align, size);
+        if ( !p ) throw std::bad_alloc();
+        return p;
+    }
+}
+
+extern "C" void decayChainAllocationCounts(unsigned long* allocations, unsigned long* bytes){
+    *allocations = nAllocations.load(std::memory_order_relaxed);
+    *bytes = nBytes.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size){return countedAllocation(size);}
+void* operator new[](std::size_t size){return countedAllocation(size);}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept{
+    try {return countedAllocation(size);}
+    catch(...) {return nullptr;}
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept{
+    try {return countedAllocation(size);}
+    catch(...) {return nullptr;}
+}
+void* operator new(std::size_t size, std::align_val_t alignment){return countedAlignedAllocation(size, alignment);}
+void* operator new[](std::size_t size, std::align_val_t alignment){return countedAlignedAllocation(size, alignment);}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept{
+    try {return countedAlignedAllocation(size, alignment);}
+    catch(...) {return nullptr;}
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept{
+    try {return countedAlignedAllocation(size, alignment);}
+    catch(...) {return nullptr;}
+}
+
+void operator delete(void* p) noexcept {std::free(p);}
+void operator delete[](void* p) noexcept {std::free(p);}
+void operator delete(void* p, std::size_t) noexcept {std::free(p);}
+void operator delete[](void* p, std::size_t) noexcept {std::free(p);}
+void operator delete(void* p, std::align_val_t) noexcept {std::free(p);}
+void operator delete[](void* p, std::align_val_t) noexcept {std::free(p);}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {std::free(p);}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {std::free(p);}
+void operator delete(void* p, const std::nothrow_t&) noexcept {std::free(p);}
+void operator delete[](void* p, const std::nothrow_t&) noexcept {std::free(p);}
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {std::free(p);}
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {std::free(p);}
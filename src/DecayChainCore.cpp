@@ -0,0 +1,541 @@
+#include "DecayChainCore.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+    // clear() keeps the capacity, which must not outlive the arena memory
+    template <typename T>
+    void release(std::pmr::vector<T>& v){
+        std::pmr::vector<T>( v.get_allocator() ).swap(v);
+    }
+}
+
+
+EventAnalysis::EventAnalysis(std::pmr::memory_resource* resource) :
+    pdg(resource),
+    vertex(resource),
+    flags(resource),
+    region(resource),
+    chainOffsets(resource),
+    chainParticles(resource),
+    vertexMetrics(resource),
+    nodes(resource),
+    edges(resource),
+    layoutGroup(resource){}
+
+void EventAnalysis::clear(){
+    nParticles = 0;
+    nVertices = 0;
+    release(pdg);
+    release(vertex);
+    release(flags);
+    release(chainOffsets);
+    release(chainParticles);
+    release(vertexMetrics);
+    release(nodes);
+    release(edges);
+    nComponents = 0;
+    nLayoutGroups = 0;
+    release(layoutGroup);
+    kinematics = Kinematics{};
+    release(region);
+    regions = nullptr;
+}
+
+
+DrawnGraph EventAnalysis::drawnGraph() const{
+    DrawnGraph graph;
+    graph.nParticles = nParticles;
+    graph.pdg = pdg.data();
+    graph.vertex = vertex.data();
+    graph.distance = kinematics.distance;
+    graph.pt = kinematics.pt;
+    graph.pz = kinematics.pz;
+    graph.nNodes = nodes.size();
+    graph.nodes = nodes.data();
+    graph.nEdges = edges.size();
+    graph.edges = edges.data();
+    graph.nLayoutGroups = nLayoutGroups;
+    graph.layoutGroup = layoutGroup.data();
+    if (regions != nullptr){
+        graph.region = region.data();
+        graph.regions = regions;
+    }
+    return graph;
+}
+
+
+DecayChainCore::DecayChainCore(std::pmr::memory_resource* resource) :
+    _resource(resource),
+    _marks(resource),
+    _hadronization(resource),
+    _chainRoots(resource),
+    _chainUnassigned(resource),
+    _counts(resource),
+    _roots(resource),
+    _components(resource){}
+
+void DecayChainCore::clear(){
+    release(_marks);
+    release(_hadronization);
+    release(_chainRoots);
+    release(_chainUnassigned);
+    release(_counts);
+    release(_roots);
+    release(_components);
+    _stamp = 0;
+}
+
+
+void DecayChainCore::beginEvent(const McGraph& graph, EventAnalysis& analysis){
+    int n = graph.nParticles;
+    analysis.nParticles = n;
+    analysis.pdg.assign(graph.pdg, graph.pdg + n);
+    analysis.vertex.assign(n, 0);
+    analysis.flags.assign(n, 0);
+    analysis.nVertices = 0;
+    analysis.chainOffsets.assign(1, 0);
+    analysis.chainParticles.clear();
+    analysis.nodes.clear();
+    analysis.edges.clear();
+
+    _marks.assign(n, 0);
+    _stamp = 0;
+    _hadronization.assign(n, 0);
+    _chainRoots.assign(n, -1);
+    _counts.assign(n, 0);
+    _roots.assign(n, 0);
+}
+
+
+void DecayChainCore::analyseMc(const McGraph& graph, EventAnalysis& analysis){
+    int n = graph.nParticles;
+    for(int i=0; i<n; ++i){
+        if ( isInHadronization(graph, i) ) analysis.flags[i] |= EventAnalysis::inHadronization;
+    }
+
+    Kinematics& kinematics = analysis.kinematics;
+    kinematics.allocate(_resource, graph);
+    // distances are measured from the vertex of the first MC particle
+    if (n > 0){
+        double ip[3] = {graph.vx[0], graph.vy[0], graph.vz[0]};
+        kinematics.compute(ip);
+    }
+    kinematics.computeEta();
+
+    analysis.regions = nullptr;
+    if (_regions == nullptr || _regions->empty()) return;
+    analysis.region.resize(n);
+    _regions->classify(kinematics.vx, kinematics.vy, kinematics.vz, n, analysis.region.data());
+    analysis.regions = _regions;
+}
+
+
+void DecayChainCore::analyseVertices(const McGraph& graph, const VertexTracks& tracks, EventAnalysis& analysis){
+    analysis.nVertices = tracks.nVertices;
+    analysis.chainOffsets.assign(1, 0);
+    analysis.chainParticles.clear();
+    analysis.vertexMetrics.clear();
+    bool withMetrics = tracks.hasReconstructed;
+    if (withMetrics) countChainUnassigned(graph, tracks);
+    for(int j=0; j<tracks.nVertices; ++j){
+        ++_stamp;
+        for(int t=tracks.trackOffsets[j]; t<tracks.trackOffsets[j+1]; ++t){
+            int mc = tracks.trackMc[t];
+            if (mc < 0 || _marks[mc] == _stamp) continue;
+            fillDecayChainUp(graph, mc, analysis.chainParticles);
+        }
+        analysis.chainOffsets.push_back( analysis.chainParticles.size() );
+        if (withMetrics) analysis.vertexMetrics.push_back( getVertexMetrics(graph, tracks, j) );
+    }
+
+    for(int j=0; j<tracks.nVertices; ++j){
+        for(int c=analysis.chainOffsets[j]; c<analysis.chainOffsets[j+1]; ++c) analysis.vertex[ analysis.chainParticles[c] ] = j+1;
+    }
+}
+
+
+void DecayChainCore::describeGraph(const McGraph& graph, EventAnalysis& analysis){
+    int n = graph.nParticles;
+    for(int i=0; i<n; ++i){
+        bool drawn = analysis.vertex[i] != 0 || (graph.generatorStatus[i] != 0 && (analysis.flags[i] & EventAnalysis::inHadronization));
+        if (drawn) analysis.flags[i] |= EventAnalysis::drawn;
+        else analysis.flags[i] &= ~EventAnalysis::drawn;
+    }
+
+    analysis.nodes.clear();
+    analysis.edges.clear();
+    for(int i=0; i<n; ++i){
+        if ( !(analysis.flags[i] & EventAnalysis::drawn) ) continue;
+        for(int d=graph.daughterOffsets[i]; d<graph.daughterOffsets[i+1]; ++d){
+            int daughter = graph.daughters[d];
+            if (analysis.flags[daughter] & EventAnalysis::drawn) analysis.edges.emplace_back(i, daughter);
+        }
+        analysis.nodes.push_back(i);
+    }
+    findLayoutGroups(analysis);
+}
+
+
+void DecayChainCore::findLayoutGroups(EventAnalysis& analysis){
+    for(auto i : analysis.nodes) _roots[i] = i;
+    for(auto& [mc, daughter] : analysis.edges){
+        int a = findRoot(mc);
+        int b = findRoot(daughter);
+        if (a != b) _roots[ std::max(a, b) ] = std::min(a, b);
+    }
+
+    // component of a root is numbered on its first node and stored in layoutGroup until grouping
+    analysis.layoutGroup.assign(analysis.nParticles, -1);
+    _components.clear();
+    for(auto i : analysis.nodes){
+        int root = findRoot(i);
+        if (analysis.layoutGroup[root] < 0){
+            analysis.layoutGroup[root] = _components.size();
+            _components.push_back(0);
+        }
+        analysis.layoutGroup[i] = analysis.layoutGroup[root];
+        ++_components[ analysis.layoutGroup[i] ];
+    }
+    int nComponents = _components.size();
+    analysis.nComponents = nComponents;
+
+    // order by size, then sizes are replaced by the group of each component
+    std::pmr::vector<int> order(nComponents, 0, _resource);
+    for(int c=0; c<nComponents; ++c) order[c] = c;
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b){return _components[a] > _components[b];});
+    int nGroups = 0;
+    int openGroup = -1;
+    int openSize = 0;
+    for(auto c : order){
+        int size = _components[c];
+        if (size >= minGroupNodes){
+            _components[c] = nGroups++;
+            continue;
+        }
+        if (openGroup < 0 || openSize >= minGroupNodes){
+            openGroup = nGroups++;
+            openSize = 0;
+        }
+        _components[c] = openGroup;
+        openSize += size;
+    }
+    analysis.nLayoutGroups = nGroups;
+    for(auto i : analysis.nodes) analysis.layoutGroup[i] = _components[ analysis.layoutGroup[i] ];
+}
+
+
+int DecayChainCore::findRoot(int mc){
+    // path halving
+    while (_roots[mc] != mc){
+        _roots[mc] = _roots[ _roots[mc] ];
+        mc = _roots[mc];
+    }
+    return mc;
+}
+
+
+void DecayChainCore::resetVertices(EventAnalysis& analysis){
+    for(auto mc : analysis.chainParticles) analysis.vertex[mc] = 0;
+    for(auto& flag : analysis.flags) flag &= ~EventAnalysis::drawn;
+    analysis.nVertices = 0;
+    analysis.chainOffsets.assign(1, 0);
+    analysis.chainParticles.clear();
+    analysis.vertexMetrics.clear();
+    analysis.nodes.clear();
+    analysis.edges.clear();
+    analysis.nComponents = 0;
+    analysis.nLayoutGroups = 0;
+    analysis.layoutGroup.clear();
+}
+
+
+void DecayChainCore::fillDecayChainUp(const McGraph& graph, int mc, std::pmr::vector<int>& decayChain){
+    decayChain.push_back(mc);
+    _marks[mc] = _stamp;
+    // stop iterating up at hadronization
+    if (graph.pdg[mc] == 92) return;
+    for(int p=graph.parentOffsets[mc]; p<graph.parentOffsets[mc+1]; ++p){
+        int parent = graph.parents[p];
+        if (_marks[parent] != _stamp) fillDecayChainUp(graph, parent, decayChain);
+    }
+}
+
+
+bool DecayChainCore::isInHadronization(const McGraph& graph, int mc){
+    if (_hadronization[mc] != 0) return _hadronization[mc] == 1;
+    bool inHadronization = graph.pdg[mc] == 92;
+    for(int p=graph.parentOffsets[mc]; !inHadronization && p<graph.parentOffsets[mc+1]; ++p){
+        inHadronization = isInHadronization(graph, graph.parents[p]);
+    }
+    _hadronization[mc] = inHadronization ? 1 : 2;
+    return inHadronization;
+}
+
+
+int DecayChainCore::findChainRoot(const McGraph& graph, int mc){
+    if (_chainRoots[mc] >= 0) return _chainRoots[mc];
+    // first parent only, below the hadronization it is the single mother
+    int first = graph.parentOffsets[mc];
+    bool isRoot = first == graph.parentOffsets[mc+1] || graph.pdg[ graph.parents[first] ] == 92;
+    _chainRoots[mc] = isRoot ? mc : findChainRoot(graph, graph.parents[first]);
+    return _chainRoots[mc];
+}
+
+
+void DecayChainCore::countChainUnassigned(const McGraph& graph, const VertexTracks& tracks){
+    _chainUnassigned.assign(graph.nParticles, 0);
+    // a particle in any vertex of the collection is not missed by the others
+    ++_stamp;
+    for(int t=0; t<tracks.trackOffsets[tracks.nVertices]; ++t){
+        int mc = tracks.trackMc[t];
+        if (mc >= 0) _marks[mc] = _stamp;
+    }
+    for(int t=0; t<tracks.nReconstructed; ++t){
+        int mc = tracks.reconstructedMc[t];
+        // split tracks of one particle count once
+        if (mc < 0 || _marks[mc] == _stamp) continue;
+        _marks[mc] = _stamp;
+        ++_chainUnassigned[ findChainRoot(graph, mc) ];
+    }
+}
+
+
+VertexMetrics DecayChainCore::getVertexMetrics(const McGraph& graph, const VertexTracks& tracks, int vertex){
+    VertexMetrics metrics;
+    int first = tracks.trackOffsets[vertex];
+    int last = tracks.trackOffsets[vertex+1];
+    metrics.nTracks = last - first;
+
+    // tracks per chain are counted on the chain root
+    std::pmr::vector<int> roots(_resource);
+    for(int t=first; t<last; ++t){
+        int mc = tracks.trackMc[t];
+        if (mc < 0) continue;
+        ++metrics.nTracksWithMc;
+        int root = findChainRoot(graph, mc);
+        if (_counts[root]++ == 0) roots.push_back(root);
+    }
+    int dominant = -1;
+    for(auto root : roots){
+        if (dominant < 0 || _counts[root] > _counts[dominant]) dominant = root;
+    }
+    metrics.nChains = roots.size();
+    if (dominant >= 0) metrics.nDominant = _counts[dominant];
+    for(auto root : roots) _counts[root] = 0;
+    if (dominant < 0) return metrics;
+
+    ++_stamp;
+    for(int t=first; t<last; ++t){
+        int mc = tracks.trackMc[t];
+        if (mc < 0 || _marks[mc] == _stamp || findChainRoot(graph, mc) != dominant) continue;
+        _marks[mc] = _stamp;
+        ++metrics.nFound;
+    }
+    metrics.nMissed = _chainUnassigned[dominant];
+    return metrics;
+}
+
+
+void DecayChainCore::markChain(const EventAnalysis& analysis, int vertex){
+    ++_stamp;
+    for(int c=analysis.chainOffsets[vertex]; c<analysis.chainOffsets[vertex+1]; ++c) _marks[ analysis.chainParticles[c] ] = _stamp;
+}
+
+
+uint64_t DecayChainCore::getTopologyHash(const McGraph& graph, const EventAnalysis& analysis, int vertex){
+    markChain(analysis, vertex);
+    // roots of the chain are particles with no parent in the chain, usually the hadronization
+    std::pmr::vector<uint64_t> rootHashes(_resource);
+    for(int c=analysis.chainOffsets[vertex]; c<analysis.chainOffsets[vertex+1]; ++c){
+        int mc = analysis.chainParticles[c];
+        bool isRoot = true;
+        for(int p=graph.parentOffsets[mc]; isRoot && p<graph.parentOffsets[mc+1]; ++p) isRoot = _marks[ graph.parents[p] ] != _stamp;
+        if (isRoot) rootHashes.push_back( getTopologyHash(graph, mc) );
+    }
+    std::sort(rootHashes.begin(), rootHashes.end());
+    uint64_t hash = 0;
+    for(auto rootHash : rootHashes) hash = mixHash(hash ^ rootHash);
+    return hash;
+}
+
+
+uint64_t DecayChainCore::getTopologyHash(const McGraph& graph, int mc){
+    // hash of a particle combines its PDG with the sorted hashes of its daughters in the chain
+    std::pmr::vector<uint64_t> daughterHashes(_resource);
+    for(int d=graph.daughterOffsets[mc]; d<graph.daughterOffsets[mc+1]; ++d){
+        int daughter = graph.daughters[d];
+        if (_marks[daughter] == _stamp) daughterHashes.push_back( getTopologyHash(graph, daughter) );
+    }
+    std::sort(daughterHashes.begin(), daughterHashes.end());
+    uint64_t hash = mixHash( uint64_t(int64_t(graph.pdg[mc])) );
+    for(auto daughterHash : daughterHashes) hash = mixHash(hash ^ daughterHash);
+    return hash;
+}
+
+
+std::string DecayChainCore::getTopologyLabel(const McGraph& graph, const EventAnalysis& analysis, int vertex){
+    markChain(analysis, vertex);
+    std::vector<std::string> rootLabels;
+    for(int c=analysis.chainOffsets[vertex]; c<analysis.chainOffsets[vertex+1]; ++c){
+        int mc = analysis.chainParticles[c];
+        bool isRoot = true;
+        for(int p=graph.parentOffsets[mc]; isRoot && p<graph.parentOffsets[mc+1]; ++p) isRoot = _marks[ graph.parents[p] ] != _stamp;
+        if (isRoot) rootLabels.push_back( getTopologyLabel(graph, mc) );
+    }
+    std::sort(rootLabels.begin(), rootLabels.end());
+    std::string label;
+    for(auto& rootLabel : rootLabels) label += (label.empty() ? "" : " ") + rootLabel;
+    return label;
+}
+
+
+std::string DecayChainCore::getTopologyLabel(const McGraph& graph, int mc){
+    std::vector<std::string> daughterLabels;
+    for(int d=graph.daughterOffsets[mc]; d<graph.daughterOffsets[mc+1]; ++d){
+        int daughter = graph.daughters[d];
+        if (_marks[daughter] == _stamp) daughterLabels.push_back( getTopologyLabel(graph, daughter) );
+    }
+    std::string label = std::to_string( graph.pdg[mc] );
+    if ( daughterLabels.empty() ) return label;
+    std::sort(daughterLabels.begin(), daughterLabels.end());
+    label += "(";
+    for(size_t i=0; i<daughterLabels.size(); ++i) label += (i == 0 ? "" : ",") + daughterLabels[i];
+    return label + ")";
+}
+
+
+int DecayChainCore::countBChains(const McGraph& graph, const EventAnalysis& analysis, int vertex) const{
+    // every weakly decaying b-hadron starts its own b chain
+    int nBChains = 0;
+    for(int c=analysis.chainOffsets[vertex]; c<analysis.chainOffsets[vertex+1]; ++c){
+        int mc = analysis.chainParticles[c];
+        if ( !isBHadron(graph.pdg[mc]) ) continue;
+        bool decaysWeakly = true;
+        for(int d=graph.daughterOffsets[mc]; decaysWeakly && d<graph.daughterOffsets[mc+1]; ++d) decaysWeakly = !isBHadron( graph.pdg[ graph.daughters[d] ] );
+        if (decaysWeakly) ++nBChains;
+    }
+    return nBChains;
+}
+
+
+EventFeatures DecayChainCore::getEventFeatures(const McGraph& graph, const VertexTracks& tracks, const EventAnalysis& analysis){
+    EventFeatures features;
+    features.nVertices = analysis.nVertices;
+
+    for(int j=0; j<analysis.nVertices; ++j){
+        markChain(analysis, j);
+        for(int k=j+1; k<analysis.nVertices; ++k){
+            for(int c=analysis.chainOffsets[k]; c<analysis.chainOffsets[k+1]; ++c){
+                int mc = analysis.chainParticles[c];
+                if (graph.pdg[mc] != 92 && _marks[mc] == _stamp){
+                    ++features.nSharedAncestors;
+                    break;
+                }
+            }
+        }
+    }
+
+    std::pmr::vector<int> trackParents(_resource);
+    for(int j=0; j<tracks.nVertices; ++j){
+        trackParents.clear();
+        for(int t=tracks.trackOffsets[j]; t<tracks.trackOffsets[j+1]; ++t){
+            int mc = tracks.trackMc[t];
+            if (mc < 0) continue;
+            bool hasParent = graph.parentOffsets[mc] < graph.parentOffsets[mc+1];
+            trackParents.push_back( hasParent ? graph.parents[ graph.parentOffsets[mc] ] : -1 );
+        }
+        long nDominant = 0;
+        for(auto parent : trackParents) nDominant = std::max<long>( nDominant, std::count(trackParents.begin(), trackParents.end(), parent) );
+        features.nWrongVertex += trackParents.size() - nDominant;
+    }
+
+    features.nNodes = analysis.nodes.size();
+    return features;
+}
+
+
+void DecayChainCore::getMembershipWeights(const McGraph& graph, const VertexTracks& tracks, int vertex, std::pmr::vector< std::pair<int, float> >& weights){
+    weights.clear();
+    int nTracks = tracks.trackOffsets[vertex+1] - tracks.trackOffsets[vertex];
+    std::pmr::vector<int> trackChain(_resource);
+    std::pmr::vector<int> touched(_resource);
+    for(int t=tracks.trackOffsets[vertex]; t<tracks.trackOffsets[vertex+1]; ++t){
+        int mc = tracks.trackMc[t];
+        if (mc < 0) continue;
+        ++_stamp;
+        trackChain.clear();
+        fillDecayChainUp(graph, mc, trackChain);
+        for(auto particle : trackChain){
+            if (_counts[particle]++ == 0) touched.push_back(particle);
+        }
+    }
+    for(auto particle : touched){
+        weights.emplace_back(particle, float(_counts[particle]) / nTracks);
+        _counts[particle] = 0;
+    }
+}
+
+
+void DecayChainCore::writeDotGraph(const DrawnGraph& graph, const std::map<int, std::string>& pdgNames, const std::vector<std::string>& vtxColors, std::pmr::string& dotGraph, int layoutGroup){
+    char line[512];
+    dotGraph.clear();
+    dotGraph += "digraph {\n";
+    dotGraph += "    rankdir=TB;\n";
+    for(int e=0; e<graph.nEdges; ++e){
+        auto [mc, daughter] = graph.edges[e];
+        if (layoutGroup >= 0 && graph.layoutGroup[mc] != layoutGroup) continue;
+        dotGraph.append(line, snprintf(line, sizeof(line), "    %d->%d;\n", mc, daughter) );
+    }
+    dotGraph += "\n";
+
+    for(int k=0; k<graph.nNodes; ++k){
+        int i = graph.nodes[k];
+        if (layoutGroup >= 0 && graph.layoutGroup[i] != layoutGroup) continue;
+        int pdg = graph.pdg[i];
+        auto name = pdgNames.find(pdg);
+        int n;
+        if ( name != pdgNames.end() ) n = snprintf(line, sizeof(line), "%d[label=<%s", i, name->second.c_str());
+        else n = snprintf(line, sizeof(line), "%d[label=<%d", i, pdg);
+        dotGraph.append(line, n);
+
+        dotGraph.append(line, snprintf(line, sizeof(line), "<BR/>%.2f mm", graph.distance[i]) );
+        if (graph.region != nullptr && graph.region[i] < graph.regions->size()) dotGraph.append(line, snprintf(line, sizeof(line), " in %s", graph.regions->name(graph.region[i]).c_str()) );
+        dotGraph.append(line, snprintf(line, sizeof(line), "<BR/>%.2f | %.2f GeV>", graph.pt[i], graph.pz[i]) );
+        int vertex = graph.vertex[i];
+        if (vertex != 0) dotGraph.append(line, snprintf(line, sizeof(line), " style=\"filled\" fillcolor=\"%s\"", vtxColors[(vertex-1) % vtxColors.size()].c_str()) );
+        dotGraph += "];\n";
+    }
+    dotGraph += "\n}\n";
+}
+
+
+std::vector< std::vector<std::string> > DecayChainCore::getVertexPalettes(){
+    return {
+        {"yellow", "yellow4", "yellowgreen", "orange", "orange4", "lightpink", "lightcoral", "lightcyan", "lightslateblue", "lightseagreen"},
+        {"lightblue", "deepskyblue", "steelblue1", "cadetblue1", "cyan3", "aquamarine", "paleturquoise", "powderblue", "lightsteelblue", "royalblue1"},
+        {"palegreen", "springgreen", "mediumseagreen", "olivedrab1", "darkseagreen1", "chartreuse2", "greenyellow", "lawngreen", "limegreen", "seagreen1"},
+        {"thistle", "plum", "orchid1", "violet", "mediumpurple1", "lavender", "pink", "hotpink", "magenta2", "mediumorchid1"}
+    };
+}
+
+
+bool DecayChainCore::isBHadron(int pdg){
+    pdg = std::abs(pdg);
+    return (pdg/100)%10 == 5 || (pdg/1000)%10 == 5;
+}
+
+
+uint64_t DecayChainCore::mixHash(uint64_t hash){
+    // splitmix64 finalizer
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
@@ -4,724 +4,654 @@
 #include "marlinutil/DDMarlinCED.h"
 #include "marlinutil/GeometryUtil.h"
 #include "marlinutil/MarlinUtil.h"
-#include "DDRec/Vector3D.h"
+#include "marlin/Global.h"
+#include "DD4hep/DD4hepUnits.h"
+#include "DD4hep/DetType.h"
+#include "DDRec/DetectorData.h"
+#include "IMPL/LCCollectionVec.h"
+#include "IMPL/LCFlagImpl.h"
+#include "IMPL/LCGenericObjectImpl.h"
+#include "IMPL/LCRelationImpl.h"
+#include "IO/LCReader.h"
+#include "IOIMPL/LCFactory.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <sstream>
 
 using namespace std;
-using dd4hep::rec::Vector3D;
 
 DecayChainDrawer aDecayChainDrawer;
 
-DecayChainDrawer::DecayChainDrawer() : Processor("DecayChainDrawer"){}
+DecayChainDrawer::DecayChainDrawer() : Processor("DecayChainDrawer"){
+    registerProcessorParameter("EventArenaSize",
+                               "Initial size in bytes of the per-event memory arena. It grows to the largest event seen",
+                               _arenaSize,
+                               int(1 << 20) );
+
+    registerInputCollections(LCIO::VERTEX,
+                             "VertexCollections",
+                             "Vertex collections analysed in one pass sharing the MC index. Each gets its own graphs, colors and outputs",
+                             _vertexCollectionNames,
+                             std::vector<std::string>{"BuildUpVertex"} );
+
+    registerProcessorParameter("OutputDirectory",
+                               "Directory for the graph files and the shard index",
+                               _outputDirectory,
+                               std::string(".") );
+
+    registerProcessorParameter("ShardName",
+                               "Prefix of all output files of this job. Empty: name of the first input file",
+                               _shardName,
+                               std::string("") );
+
+    registerProcessorParameter("DrawGraphs",
+                               "Write and render a graph per event. Switch off to only collect topology statistics",
+                               _drawGraphs,
+                               true );
+
+    registerProcessorParameter("CountTopologies",
+                               "Count canonical PDG topologies of the vertex decay chains and write a ranked summary in end()",
+                               _countTopologies,
+                               false );
+
+    registerProcessorParameter("VertexingMetrics",
+                               "Compute the truth purity, efficiency, merged decay chains and missed tracks of every vertex while building the chains and write their histograms in end()",
+                               _vertexingMetrics,
+                               false );
+
+    registerProcessorParameter("SamplingMode",
+                               "Which events are drawn: all, reservoir (uniform random sample) or topK (highest score). Sampled events are drawn in end()",
+                               _samplingMode,
+                               std::string("all") );
+
+    registerProcessorParameter("SampleSize",
+                               "Number of events kept by the reservoir or topK sampling",
+                               _sampleSize,
+                               int(10) );
+
+    registerProcessorParameter("SamplingSeed",
+                               "Seed of the reservoir sampling",
+                               _samplingSeed,
+                               int(0) );
+
+    registerProcessorParameter("ScoreWeights",
+                               "Weights of the topK event score: vertices, vertex pairs sharing ancestors, tracks in a wrong vertex, drawn nodes",
+                               _scoreWeights,
+                               std::vector<float>{1., 1., 1., 0.01} );
+
+    registerProcessorParameter("MemoryAccounting",
+                               "Report heap allocations per event and stage and the resident memory in end(). Allocation counts need LD_PRELOAD=libDecayChainAllocCounter.so",
+                               _memoryAccounting,
+                               false );
+
+    registerProcessorParameter("PerfCounters",
+                               "Count cycles, instructions, cache misses and branch misses per processing stage with perf_event_open and report them in end()",
+                               _perfCounters,
+                               false );
+
+    registerProcessorParameter("GoldenMode",
+                               "Regression gate: off, record (write golden graphs and budgets) or compare (fail in end() on any difference or exceeded budget). Graphs are not rendered",
+                               _goldenMode,
+                               std::string("off") );
+
+    registerProcessorParameter("GoldenDirectory",
+                               "Directory of the golden graphs and budgets.txt",
+                               _goldenDirectory,
+                               std::string("golden") );
+
+    registerProcessorParameter("BudgetMargin",
+                               "Allowed relative excess over the recorded time and allocation budgets",
+                               _budgetMargin,
+                               float(0.2) );
+
+    registerProcessorParameter("WriteMembership",
+                               "Add the vertex-MC membership to the event as output collections. Needs AllowToModifyEvent true",
+                               _writeMembership,
+                               false );
+
+    registerOutputCollection(LCIO::LCRELATION,
+                             "VertexMCRelation",
+                             "Relation from each vertex to the MCParticles of its decay chain, weight is the fraction of the vertex tracks descending from the MCParticle. Suffixed with _<vertex collection> for several VertexCollections",
+                             _vertexMcRelationName,
+                             std::string("VertexDecayChainMCTruthLink") );
+
+    registerOutputCollection(LCIO::LCGENERICOBJECT,
+                             "MCParticleFlags",
+                             "Per-MCParticle flags in MCParticle collection order: vertex index + 1, in hadronization, drawn. Suffixed with _<vertex collection> for several VertexCollections",
+                             _mcFlagsName,
+                             std::string("DecayChainMCFlags") );
+
+    registerProcessorParameter("RenderTimeout",
+                               "Time budget in seconds of the graph layout. Slower layouts are killed and retried with a reduced layout, then left as plain DOT. 0: no limit",
+                               _renderTimeout,
+                               float(10.) );
+
+    registerProcessorParameter("LayoutThreads",
+                               "Threads laying out the disconnected parts of a graph concurrently, packed with gvpack afterwards, which changes the layout. 1: one dot layout per graph, 0: all cores",
+                               _layoutThreads,
+                               int(1) );
+
+    registerProcessorParameter("AnalysisCacheDirectory",
+                               "Directory of the per-event analysis cache <ShardName>.cache. A cache of the same input files is reused and only drawing options take effect, else it is written. Empty: no cache",
+                               _cacheDirectory,
+                               std::string("") );
+
+    registerProcessorParameter("ViewerRing",
+                               "Shared-memory ring of a running DecayChainViewer. Graphs are handed to it instead of being written and rendered here. Empty: always write files",
+                               _viewerRing,
+                               std::string("") );
+
+    registerProcessorParameter("AnnotateRegions",
+                               "Label every node with the detector region of its production vertex, from a radial table built from the DD4hep geometry in init()",
+                               _annotateRegions,
+                               true );
+
+    registerProcessorParameter("OpenViewer",
+                               "Open every rendered graph with xdg-open. Switch off in batch jobs",
+                               _openViewer,
+                               true );
+}
 
 void DecayChainDrawer::init(){
-    _pdg2str = getPdgNamesMap();
+    _pdg2str = DecayChainCore::getPdgNamesMap();
+    _arena.reserve(_arenaSize);
+    _renderer.setup(_renderTimeout, _layoutThreads);
+
+    std::vector<std::string> inputFiles;
+    marlin::Global::parameters->getStringVals("LCIOInputFiles", inputFiles);
+    // run and event numbers of every input tie each graph of the shard index to its file
+    std::unique_ptr<IO::LCReader> reader( IOIMPL::LCFactory::getInstance()->createLCReader() );
+    for(auto& file : inputFiles){
+        EVENT::IntVec runEvents;
+        try{
+            reader->open(file);
+            reader->getEvents(runEvents);
+            reader->close();
+        }
+        catch(const std::exception& exception){
+            streamlog_out(WARNING)<<"Cannot list the events of "<<file<<", its graphs are not tied to it in the shard index: "<<exception.what()<<std::endl;
+            runEvents.clear();
+        }
+        _shardIndex.addInput(std::filesystem::absolute(file).lexically_normal().string(), runEvents);
+    }
+    if ( _shardName.empty() ){
+        if ( !inputFiles.empty() ) _shardName = std::filesystem::path(inputFiles[0]).stem().string();
+        else _shardName = "DecayChainDrawer";
+    }
+    _shardIndex.name = _shardName;
+    std::filesystem::create_directories(_outputDirectory);
+
+    if (_samplingMode == "all") _sampling = Sampling::all;
+    else if (_samplingMode == "reservoir") _sampling = Sampling::reservoir;
+    else if (_samplingMode == "topK") _sampling = Sampling::topK;
+    else throw EVENT::Exception("DecayChainDrawer: unknown SamplingMode " + _samplingMode);
+    if ( _scoreWeights.size() != 4 ) throw EVENT::Exception("DecayChainDrawer: ScoreWeights needs 4 values");
+    if (_sampleSize <= 0) throw EVENT::Exception("DecayChainDrawer: SampleSize must be positive");
+    _random.seed(_samplingSeed);
+
+    for(size_t i=0; i<_vertexCollectionNames.size(); ++i){
+        VertexCollection collection;
+        collection.name = _vertexCollectionNames[i];
+        collection.palette = i % _vtxPalettes.size();
+        std::string suffix = _vertexCollectionNames.size() > 1 ? "_" + collection.name : "";
+        collection.vertexMcRelationName = _vertexMcRelationName + suffix;
+        collection.mcFlagsName = _mcFlagsName + suffix;
+        collection.sample.reserve(_sampleSize);
+        _vertexCollections.push_back( std::move(collection) );
+    }
+
+    if (_goldenMode == "off") _gate.setup(RegressionGate::Mode::off, _goldenDirectory, _budgetMargin);
+    else if (_goldenMode == "record") _gate.setup(RegressionGate::Mode::record, _goldenDirectory, _budgetMargin);
+    else if (_goldenMode == "compare") _gate.setup(RegressionGate::Mode::compare, _goldenDirectory, _budgetMargin);
+    else throw EVENT::Exception("DecayChainDrawer: unknown GoldenMode " + _goldenMode);
+
+    if (_writeMembership){
+        std::string allowToModify = marlin::Global::parameters->getStringVal("AllowToModifyEvent");
+        if (allowToModify != "true" && allowToModify != "1"){
+            streamlog_out(WARNING)<<"WriteMembership is ignored as AllowToModifyEvent is not true in the global steering"<<std::endl;
+            _writeMembership = false;
+        }
+    }
+
+    if (_annotateRegions){
+        // detector types are only available once a geometry is loaded, e.g. by InitDD4hep
+        bool hasGeometry = dd4hep::Detector::getInstance().state() == dd4hep::Detector::READY;
+        if (hasGeometry) buildDetectorRegions();
+        if ( !hasGeometry ) streamlog_out(WARNING)<<"AnnotateRegions: no DD4hep geometry is loaded, nodes are not annotated"<<std::endl;
+        else if ( _detectorRegions.empty() ) streamlog_out(WARNING)<<"AnnotateRegions: no tracker or calorimeter barrel data in the DD4hep geometry, nodes are not annotated"<<std::endl;
+        else _core.setDetectorRegions(&_detectorRegions);
+    }
+
+    if ( !_cacheDirectory.empty() ){
+        // topology counts, vertex metrics and membership need the vertex chains, which are not cached
+        if (_countTopologies || _vertexingMetrics || _writeMembership) streamlog_out(WARNING)<<"AnalysisCacheDirectory is ignored with CountTopologies, VertexingMetrics or WriteMembership"<<std::endl;
+        else{
+            std::filesystem::create_directories(_cacheDirectory);
+            std::string cachePath = _cacheDirectory + "/" + _shardName + ".cache";
+            _cache.open(cachePath, inputFiles);
+            if (_cache.mode() == AnalysisCache::Mode::read) streamlog_out(MESSAGE)<<"Drawing from analysis cache "<<cachePath<<" with "<<_cache.nRecords()<<" records"<<std::endl;
+            else streamlog_out(MESSAGE)<<"Writing analysis cache "<<cachePath<<std::endl;
+        }
+    }
+
+    if ( !_viewerRing.empty() ){
+        if ( _ring.open(_viewerRing) ) streamlog_out(MESSAGE)<<"Handing graphs to DecayChainViewer on ring "<<_viewerRing<<std::endl;
+        else streamlog_out(WARNING)<<"No DecayChainViewer running on ring "<<_viewerRing<<", graphs are written to files"<<std::endl;
+    }
+
+    if (_perfCounters){
+        int nCounters = _perf.enable();
+        if (nCounters == 0) streamlog_out(WARNING)<<"PerfCounters: perf_event_open is not available, check perf_event_paranoid or the container seccomp profile"<<std::endl;
+        else if (nCounters < PerfCounters::nCounters) streamlog_out(WARNING)<<"PerfCounters: only "<<nCounters<<" of "<<PerfCounters::nCounters<<" hardware counters are available"<<std::endl;
+    }
+
+    // allocation budgets of the regression gate come from the memory monitor
+    if (_memoryAccounting || _gate.mode() != RegressionGate::Mode::off){
+        _memory.enable();
+        if ( !_memory.hasAllocationCounts() ) streamlog_out(WARNING)<<"MemoryAccounting: libDecayChainAllocCounter.so is not preloaded, only RSS is monitored"<<std::endl;
+    }
 }
 
 
 void DecayChainDrawer::processEvent(LCEvent* event){
     std::cout<<++_nEvent<<std::endl;
-    _p2idx.clear();
-    _p2vtx.clear();
-    _p2hadronization.clear();
-    _p2distance.clear();
-    _p2pt.clear();
-    _p2pz.clear();
+    MemoryMonitor::EventScope memoryScope(_memory);
+    RegressionGate::EventTimer eventTimer(_gate);
+    // containers must be emptied before their arena memory is dropped
+    _analysis.clear();
+    _core.clear();
+    _adapter.clear();
+    _arena.reset();
+
+    // cached events go straight to drawing
+    if ( drawFromCache(event) ) return;
 
     LCCollection* mcCol = event->getCollection("MCParticle");
-    LCCollection* vertices = event->getCollection("BuildUpVertex");
-    LCRelationNavigator navRecoToMc( event->getCollection("RecoMCTruthLink") );
+    LCCollection* recoMcLinks = event->getCollection("RecoMCTruthLink");
+    LCRelationNavigator navRecoToMc(recoMcLinks);
+
+    beginStage(ProcessingStage::maps);
+    const McGraph& graph = _adapter.setMcParticles(mcCol);
+    _core.beginEvent(graph, _analysis);
+    // missed tracks are counted against all charged particles of the event
+    if (_vertexingMetrics) _adapter.setReconstructedParticles(recoMcLinks, navRecoToMc);
+    endStage(ProcessingStage::maps);
+
+    // MC side is analysed by the first collection that needs it and shared by all others
+    _mcAnalysed = false;
+    _mcCached = false;
+    for(auto& collection : _vertexCollections) processVertexCollection(event, collection, navRecoToMc);
+}
 
-    MCParticle* mc0 = static_cast<MCParticle*> (mcCol->getElementAt(0));
-    Vector3D ip( mc0->getVertex() );
+
+void DecayChainDrawer::processVertexCollection(LCEvent* event, VertexCollection& collection, const LCRelationNavigator& navRecoToMc){
+    LCCollection* vertices = event->getCollection(collection.name);
     int nVertices = vertices->getNumberOfElements();
-    if (nVertices == 0) return;
-
-
-    // Fill maps
-    for(int i=0; i< mcCol->getNumberOfElements(); ++i){
-        MCParticle* mc = static_cast<MCParticle*> (mcCol->getElementAt(i));
-        _p2idx[mc] = i;
-        _p2distance[mc] = (Vector3D( mc->getVertex() ) - ip).r();
-        _p2vtx[mc] = 0;
-        _p2pt[mc] = Vector3D(mc->getMomentum()).trans();
-        _p2pz[mc] = Vector3D(mc->getMomentum()).z();
-
-        // is MCParticle in the hadronization decay?
-        _p2hadronization[mc] = isInHadronization(mc);
-
-        for(int j=0; j<nVertices; ++j){
-            Vertex* vertex = static_cast<Vertex*> (vertices->getElementAt(j));
-            vector<MCParticle*> vertexDecayChain = getVertexDecayChain(vertex, navRecoToMc);
-            bool foundInTheVertexDecay = std::find(vertexDecayChain.begin(), vertexDecayChain.end(), mc) != vertexDecayChain.end();
-            if (foundInTheVertexDecay) _p2vtx[mc] = j+1;
+    // membership collections are written for every event
+    if (nVertices == 0 && !_writeMembership) return;
+    const McGraph& graph = _adapter.graph();
+
+    // decay chain of every vertex is built once
+    beginStage(ProcessingStage::chains);
+    const VertexTracks& tracks = _adapter.setVertices(vertices, navRecoToMc);
+    _core.analyseVertices(graph, tracks, _analysis);
+    if (_vertexingMetrics) collection.vertexing.fill( _analysis.vertexMetrics.data(), _analysis.vertexMetrics.size() );
+    if (_countTopologies){
+        for(int j=0; j<nVertices; ++j) countTopology(collection, j, event);
+    }
+    endStage(ProcessingStage::chains);
+
+    if (_drawGraphs || _writeMembership){
+        beginStage(ProcessingStage::maps);
+        if ( !_mcAnalysed ) _core.analyseMc(graph, _analysis);
+        _mcAnalysed = true;
+        _core.describeGraph(graph, _analysis);
+        endStage(ProcessingStage::maps);
+
+        if (_writeMembership) addMembershipCollections(event, collection, vertices);
+        if (_drawGraphs && nVertices > 0){
+            EventFeatures features;
+            if (_sampling != Sampling::all || _cache.mode() == AnalysisCache::Mode::write){
+                beginStage(ProcessingStage::sampling);
+                features = _core.getEventFeatures(graph, tracks, _analysis);
+                endStage(ProcessingStage::sampling);
+            }
+            if ( !_mcCached ) _cache.addMc(event->getRunNumber(), event->getEventNumber(), graph, _analysis);
+            _mcCached = true;
+            _cache.addVertices(event->getRunNumber(), event->getEventNumber(), collection.name, _analysis, features);
+            drawVertexCollection(event, collection, _analysis.drawnGraph(), features);
         }
     }
 
-    // draw all MC Particles with their relations:
-    std::stringstream nodes;
-    std::stringstream labels;
-    for(int i=0; i < mcCol->getNumberOfElements(); ++i){
-        MCParticle* mc = static_cast<MCParticle*> (mcCol->getElementAt(i));
-        if (! ( _p2vtx[mc] !=0 || (mc->getGeneratorStatus() != 0 && _p2hadronization[mc] )) ) continue;
+    // membership of the next collection starts from scratch
+    _core.resetVertices(_analysis);
+}
+
 
-        for( auto daughter : mc->getDaughters() ){
-            if (! ( _p2vtx[daughter] !=0 || (daughter->getGeneratorStatus() != 0 && _p2hadronization[daughter] )) ) continue;
-            nodes<<"    "<<_p2idx[mc]<<"->"<<_p2idx[daughter]<<";"<<endl;
+bool DecayChainDrawer::drawFromCache(LCEvent* event){
+    if (_cache.mode() != AnalysisCache::Mode::read || !_drawGraphs) return false;
+    int nCollections = _vertexCollections.size();
+    pmr::vector<char> hasVertices(nCollections, &_arena);
+    _cachedNames.clear();
+    for(int i=0; i<nCollections; ++i){
+        const std::string& name = _vertexCollections[i].name;
+        // events without vertices are not drawn, so not cached either
+        hasVertices[i] = event->getCollection(name)->getNumberOfElements() > 0;
+        if ( hasVertices[i] ) _cachedNames.push_back(name);
+    }
+    AnalysisCache::McRecord mc;
+    if ( !_cache.find(event->getRunNumber(), event->getEventNumber(), _cachedNames, mc, _cachedVertices) ) return false;
+
+    // graph selection is redone from the cached analysis, so it follows the current drawing code
+    const McGraph& graph = mc.graph;
+    _core.beginEvent(graph, _analysis);
+    int c = 0;
+    for(int i=0; i<nCollections; ++i){
+        if ( !hasVertices[i] ) continue;
+        const AnalysisCache::VertexRecord& record = _cachedVertices[c++];
+        beginStage(ProcessingStage::maps);
+        _analysis.vertex.assign(record.vertex, record.vertex + graph.nParticles);
+        _analysis.flags.assign(mc.flags, mc.flags + graph.nParticles);
+        _core.describeGraph(graph, _analysis);
+        endStage(ProcessingStage::maps);
+
+        DrawnGraph drawnGraph = _analysis.drawnGraph();
+        drawnGraph.distance = mc.distance;
+        drawnGraph.pt = mc.pt;
+        drawnGraph.pz = mc.pz;
+        // region indices are cached, their names come from the current table
+        bool hasRegions = mc.region != nullptr && std::all_of(mc.region, mc.region + graph.nParticles, [this](int region){return region >= 0 && region < _detectorRegions.size();});
+        if (hasRegions){
+            drawnGraph.region = mc.region;
+            drawnGraph.regions = &_detectorRegions;
         }
+        drawVertexCollection(event, _vertexCollections[i], drawnGraph, record.features);
+        _core.resetVertices(_analysis);
+    }
+    return true;
+}
 
-        int pdg = mc->getPDG();
-        bool hasName = _pdg2str.find(pdg) != _pdg2str.end();
-        string label;
-        if (hasName) label = _pdg2str[pdg];
-        else label = std::to_string(pdg);
 
-        labels<<_p2idx[mc]<<"[label=<"<<label<<"<BR/>"<<std::fixed<<std::setprecision(2)<<_p2distance[mc]<<" mm<BR/>"<<_p2pt[mc]<<" | "<<_p2pz[mc]<<" GeV"<<">";
-        if (_p2vtx[mc] != 0 ) labels<<" style=\"filled\" fillcolor=\""<<_vtxColors[_p2vtx[mc]-1]<<"\"";
-        labels<<"];"<<endl;
+void DecayChainDrawer::drawVertexCollection(LCEvent* event, VertexCollection& collection, const DrawnGraph& graph, const EventFeatures& features){
+    int sampleSlot = -1;
+    double score = 0.;
+    if (_sampling != Sampling::all){
+        beginStage(ProcessingStage::sampling);
+        score = getEventScore(features);
+        sampleSlot = getSampleSlot(collection, score);
+        endStage(ProcessingStage::sampling);
+        // layout of events out of the sample is never done
+        if (sampleSlot < 0) return;
     }
 
-    //create dot file with a header
-    std::ofstream outfile;
-    outfile.open("test.dot");
-    outfile<<"digraph {"<<endl;
-    outfile<<"    rankdir=TB;"<<endl;
-    outfile<<nodes.str()<<endl;
-    outfile<<labels.str()<<endl;
-
-    outfile<<"}"<<endl;
-    system("rm -f test.svg && dot -Tsvg test.dot > test.svg");
-    system("xdg-open test.svg");  
+    beginStage(ProcessingStage::graph);
+    pmr::string dotGraph(&_arena);
+    DecayChainCore::writeDotGraph(graph, _pdg2str, _vtxPalettes[collection.palette], dotGraph);
+    endStage(ProcessingStage::graph);
+
+    // headless regression run
+    if (_gate.mode() != RegressionGate::Mode::off){
+        _gate.checkGraph(collection.name, event->getRunNumber(), event->getEventNumber(), dotGraph);
+        return;
+    }
+
+    //named uniquely across shards and vertex collections
+    std::string graphName = _shardName + "_" + collection.name + "_r" + std::to_string( event->getRunNumber() ) + "_e" + std::to_string( event->getEventNumber() );
+    std::vector<std::string> groupGraphs;
+    if (_sampling != Sampling::all){
+        // the analysis is gone when samples are drawn in end(), with a viewer they are handed over whole
+        if ( !_ring.isOpen() ) groupGraphs = getGroupGraphs(graph, collection);
+        beginStage(ProcessingStage::render);
+        addSample(collection, sampleSlot, {score, event->getRunNumber(), event->getEventNumber(), graphName, std::string(dotGraph), std::move(groupGraphs)});
+        endStage(ProcessingStage::render);
+        return;
+    }
+
+    beginStage(ProcessingStage::render);
+    bool published = _ring.publish(graphName, event->getRunNumber(), event->getEventNumber(), dotGraph);
+    endStage(ProcessingStage::render);
+    if (published) return;
+    groupGraphs = getGroupGraphs(graph, collection);
+    beginStage(ProcessingStage::render);
+    renderGraph(graphName, dotGraph, groupGraphs, collection.name, event->getRunNumber(), event->getEventNumber());
+    endStage(ProcessingStage::render);
 }
 
 
-void DecayChainDrawer::fillDecayChainUp(EVENT::MCParticle* mc, std::vector<EVENT::MCParticle*>& decayChain){
-    decayChain.push_back(mc);
-    // stop iterating up at hadronization
-    if(mc->getPDG() == 92) return;
-    const vector<MCParticle*> parents = mc->getParents();
-    for(auto parent : parents){
-        bool foundInTheList = std::find(decayChain.begin(), decayChain.end(), parent) != decayChain.end();
-        if ( !foundInTheList ) fillDecayChainUp(parent, decayChain);
+std::vector<std::string> DecayChainDrawer::getGroupGraphs(const DrawnGraph& graph, const VertexCollection& collection){
+    std::vector<std::string> groupGraphs;
+    if ( !_renderer.isParallel() || graph.nLayoutGroups < 2 ) return groupGraphs;
+    beginStage(ProcessingStage::graph);
+    pmr::string groupGraph(&_arena);
+    for(int g=0; g<graph.nLayoutGroups; ++g){
+        DecayChainCore::writeDotGraph(graph, _pdg2str, _vtxPalettes[collection.palette], groupGraph, g);
+        groupGraphs.emplace_back(groupGraph);
     }
+    endStage(ProcessingStage::graph);
+    return groupGraphs;
+}
+
+
+void DecayChainDrawer::beginStage(ProcessingStage stage){
+    _memory.beginStage(stage);
+    _perf.beginStage(stage);
 }
 
-void DecayChainDrawer::fillDecayChainDown(EVENT::MCParticle* mc, std::vector<EVENT::MCParticle*>& decayChain){
-    // stop iterating down at particles not created by generator
-    // if(mc->getGeneratorStatus() == 0) return;
-    decayChain.push_back(mc);
-    const vector<MCParticle*> daughters = mc->getDaughters();
-    for(auto daughter : daughters){
-        bool foundInTheList = std::find(decayChain.begin(), decayChain.end(), daughter) != decayChain.end();
-        if ( !foundInTheList ) fillDecayChainDown(daughter, decayChain);
+
+void DecayChainDrawer::endStage(ProcessingStage stage){
+    // counters first, so they do not see the memory accounting
+    _perf.endStage(stage);
+    _memory.endStage(stage);
+}
+
+
+void DecayChainDrawer::writeGraph(const std::string& graphName, std::string_view dotGraph, const std::vector<std::string>& groupGraphs, const std::string& collectionName, int run, int event){
+    // the viewer lays out and shows the graph, files only if it cannot take it.
+    // Samples come in one burst, so a full ring is given the time the viewer needs for one layout
+    if ( _ring.publish(graphName, run, event, dotGraph, _renderTimeout) ) return;
+    renderGraph(graphName, dotGraph, groupGraphs, collectionName, run, event);
+}
+
+
+void DecayChainDrawer::renderGraph(const std::string& graphName, std::string_view dotGraph, const std::vector<std::string>& groupGraphs, const std::string& collectionName, int run, int event){
+    std::string graphPath = _outputDirectory + "/" + graphName;
+    std::ofstream outfile;
+    outfile.open(graphPath + ".dot");
+    outfile<<dotGraph;
+    outfile.close();
+
+    GraphRenderer::Result result = _renderer.render(graphPath, groupGraphs);
+    if (result == GraphRenderer::Result::reduced) streamlog_out(WARNING)<<"Layout of "<<graphName<<" exceeded "<<_renderTimeout<<" s, rendered with reduced layout"<<std::endl;
+    else if (result == GraphRenderer::Result::plainDot) streamlog_out(WARNING)<<"Layout of "<<graphName<<" exceeded "<<_renderTimeout<<" s twice, only the .dot file is written"<<std::endl;
+    else if (result == GraphRenderer::Result::failed) streamlog_out(ERROR)<<"dot failed to render "<<graphName<<std::endl;
+
+    bool hasSvg = result == GraphRenderer::Result::rendered || result == GraphRenderer::Result::reduced;
+    _shardIndex.add(run, event, collectionName, graphName + (hasSvg ? ".svg" : ".dot") );
+    if (_openViewer && hasSvg) system( ("xdg-open " + graphPath + ".svg").c_str() );
+}
+
+
+double DecayChainDrawer::getEventScore(const EventFeatures& features){
+    double score = _scoreWeights[0]*features.nVertices + _scoreWeights[1]*features.nSharedAncestors + _scoreWeights[2]*features.nWrongVertex + _scoreWeights[3]*features.nNodes;
+    streamlog_out(DEBUG)<<"Event score "<<score<<": "<<features.nVertices<<" vertices, "<<features.nSharedAncestors<<" shared ancestors, "<<features.nWrongVertex<<" tracks in wrong vertex, "<<features.nNodes<<" nodes"<<std::endl;
+    return score;
+}
+
+
+int DecayChainDrawer::getSampleSlot(VertexCollection& collection, double score){
+    std::vector<SampledGraph>& sample = collection.sample;
+    int nSampled = sample.size();
+    if (_sampling == Sampling::reservoir){
+        ++collection.nSampleCandidates;
+        if (nSampled < _sampleSize) return nSampled;
+        long j = std::uniform_int_distribution<long>(0, collection.nSampleCandidates-1)(_random);
+        return j < _sampleSize ? j : -1;
     }
+    // top-K: front of the min-heap holds the lowest kept score
+    if (nSampled < _sampleSize) return nSampled;
+    return score > sample.front().score ? 0 : -1;
 }
 
-EVENT::MCParticle* DecayChainDrawer::getMcMaxTrackWeight(EVENT::ReconstructedParticle* pfo, UTIL::LCRelationNavigator nav){
-    const vector<LCObject*>& mcs = nav.getRelatedToObjects(pfo);
-    const vector<float>& weights = nav.getRelatedToWeights(pfo);
-    //get index of highest TRACK weight MC particle
-    int i = std::max_element(weights.begin(), weights.end(), [](float a, float b){return (int(a)%10000)/1000. < (int(b)%10000)/1000.;}) - weights.begin();
-    return static_cast<MCParticle*> ( mcs[i] );
+
+void DecayChainDrawer::addSample(VertexCollection& collection, int slot, SampledGraph graph){
+    std::vector<SampledGraph>& sample = collection.sample;
+    auto byScore = [](const SampledGraph& a, const SampledGraph& b){return a.score > b.score;};
+    if (_sampling == Sampling::topK && slot < int(sample.size()) ){
+        std::pop_heap(sample.begin(), sample.end(), byScore);
+        sample.pop_back();
+        slot = sample.size();
+    }
+    if ( slot == int(sample.size()) ) sample.push_back( std::move(graph) );
+    else sample[slot] = std::move(graph);
+    if (_sampling == Sampling::topK) std::push_heap(sample.begin(), sample.end(), byScore);
 }
 
 
-std::vector<EVENT::MCParticle*> DecayChainDrawer::getVertexDecayChain(EVENT::Vertex* vertex, UTIL::LCRelationNavigator navRecoToMc){
-    vector<MCParticle*> decayChain;
-    std::vector <ReconstructedParticle*> pfos = vertex->getAssociatedParticle()->getParticles();
-    for(auto pfo : pfos){
-        MCParticle* mc = getMcMaxTrackWeight(pfo, navRecoToMc);
-        fillDecayChainUp(mc, decayChain);
+void DecayChainDrawer::addMembershipCollections(LCEvent* event, const VertexCollection& collection, LCCollection* vertices){
+    // Vertex -> MCParticle of its decay chain, weight is the fraction of the vertex tracks descending from the MCParticle
+    LCCollectionVec* relations = new LCCollectionVec(LCIO::LCRELATION);
+    // without the flag the weights are not written out
+    LCFlagImpl relationFlag;
+    relationFlag.setBit(LCIO::LCREL_WEIGHTED);
+    relations->setFlag( relationFlag.getFlag() );
+    relations->parameters().setValue("FromType", LCIO::VERTEX);
+    relations->parameters().setValue("ToType", LCIO::MCPARTICLE);
+
+    pmr::vector< std::pair<int, float> > weights(&_arena);
+    for(int j=0; j<vertices->getNumberOfElements(); ++j){
+        _core.getMembershipWeights(_adapter.graph(), _adapter.tracks(), j, weights);
+        for(auto [mc, weight] : weights) relations->addElement( new LCRelationImpl(vertices->getElementAt(j), _adapter.mcParticle(mc), weight) );
+    }
+    event->addCollection(relations, collection.vertexMcRelationName);
+
+    // one object per MCParticle in collection order
+    LCCollectionVec* flags = new LCCollectionVec(LCIO::LCGENERICOBJECT);
+    flags->parameters().setValue("DataDescription", "int: vertex (index in " + collection.name + " + 1, 0 if none), inHadronization, drawn");
+    for(int i=0; i < _analysis.nParticles; ++i){
+        LCGenericObjectImpl* flag = new LCGenericObjectImpl(3, 0, 0);
+        flag->setIntVal(0, _analysis.vertex[i]);
+        flag->setIntVal(1, (_analysis.flags[i] & EventAnalysis::inHadronization) != 0);
+        flag->setIntVal(2, (_analysis.flags[i] & EventAnalysis::drawn) != 0);
+        flags->addElement(flag);
     }
-    return decayChain;    
+    event->addCollection(flags, collection.mcFlagsName);
 }
 
 
-bool DecayChainDrawer::isInHadronization(EVENT::MCParticle* mc){
-    if ( mc->getPDG() == 92 ) return true;
-    const vector<MCParticle*> parents = mc->getParents();
-    for(auto parent : parents){
-        if ( isInHadronization(parent) ) return true;
+void DecayChainDrawer::end(){
+    for(auto& collection : _vertexCollections){
+        if (_sampling != Sampling::all){
+            std::vector<SampledGraph>& sample = collection.sample;
+            std::sort(sample.begin(), sample.end(), [](const SampledGraph& a, const SampledGraph& b){return a.score > b.score;});
+            for(auto& graph : sample){
+                streamlog_out(MESSAGE)<<"Drawing sampled "<<collection.name<<" event "<<graph.run<<":"<<graph.event<<" with score "<<graph.score<<std::endl;
+                writeGraph(graph.name, graph.dotGraph, graph.groupGraphs, collection.name, graph.run, graph.event);
+            }
+            streamlog_out(MESSAGE)<<sample.size()<<" "<<collection.name<<" events drawn out of "<<_nEvent<<std::endl;
+        }
+
+        if (_countTopologies){
+            TopologyTable& topologies = collection.topologies;
+            std::string topologyPath = _outputDirectory + "/" + _shardName + "_" + collection.name + "_topologies.txt";
+            if ( topologies.write(topologyPath) ) streamlog_out(MESSAGE)<<topologies.size()<<" distinct topologies of "<<topologies.total()<<" "<<collection.name<<" vertices written to "<<topologyPath<<std::endl;
+            else streamlog_out(ERROR)<<"Cannot write topology summary "<<topologyPath<<std::endl;
+        }
+
+        if (_vertexingMetrics){
+            std::string vertexingPath = _outputDirectory + "/" + _shardName + "_" + collection.name + "_vertexing.txt";
+            std::stringstream report;
+            collection.vertexing.print(report);
+            streamlog_out(MESSAGE)<<collection.name<<" "<<report.str();
+            if ( collection.vertexing.write(vertexingPath) ) streamlog_out(MESSAGE)<<"Vertexing histograms written to "<<vertexingPath<<std::endl;
+            else streamlog_out(ERROR)<<"Cannot write vertexing histograms "<<vertexingPath<<std::endl;
+        }
+    }
+
+    if ( _ring.isOpen() ){
+        std::stringstream ringReport;
+        ringReport<<_ring.nPublished()<<" graphs handed to DecayChainViewer, "<<_ring.nRejected()<<" written to files as the ring stayed full or the viewer was gone"<<std::endl;
+        if (_ring.nRejected() > 0) streamlog_out(WARNING)<<ringReport.str();
+        else streamlog_out(MESSAGE)<<ringReport.str();
+    }
+    if (_drawGraphs && _gate.mode() == RegressionGate::Mode::off){
+        std::stringstream renderReport;
+        _renderer.print(renderReport);
+        if (_renderer.nTimeouts() > 0) streamlog_out(WARNING)<<renderReport.str();
+        else streamlog_out(MESSAGE)<<renderReport.str();
+    }
+
+    if (_cache.mode() == AnalysisCache::Mode::read) streamlog_out(MESSAGE)<<"Analysis cache: "<<_cache.nHits()<<" events reused, "<<_cache.nMisses()<<" events analysed"<<std::endl;
+    else if (_cache.mode() == AnalysisCache::Mode::write){
+        long nRecords = _cache.nRecords();
+        if ( _cache.close() ) streamlog_out(MESSAGE)<<"Analysis cache with "<<nRecords<<" records written to "<<_cacheDirectory<<std::endl;
+        else streamlog_out(ERROR)<<"Cannot write analysis cache to "<<_cacheDirectory<<std::endl;
+        if (_cache.nDuplicates() > 0) streamlog_out(WARNING)<<"Analysis cache: "<<_cache.nDuplicates()<<" records of a (run, event) found more than once in the input files, only the first is reused"<<std::endl;
+    }
+
+    std::string indexPath = _outputDirectory + "/" + _shardName + ".index";
+    if ( _shardIndex.write(indexPath) ) streamlog_out(MESSAGE)<<"Shard index with "<<_shardIndex.entries.size()<<" graphs written to "<<indexPath<<std::endl;
+    else streamlog_out(ERROR)<<"Cannot write shard index "<<indexPath<<std::endl;
+    streamlog_out(MESSAGE)<<"Per-event arena: "<<_arena.capacity()<<" bytes reserved, largest event used "<<_arena.peak()<<" bytes"<<std::endl;
+    if ( _memory.isEnabled() ){
+        std::stringstream report;
+        _memory.print(report);
+        streamlog_out(MESSAGE)<<report.str();
+    }
+    if ( _perf.isEnabled() ){
+        std::stringstream report;
+        _perf.print(report);
+        streamlog_out(MESSAGE)<<report.str();
     }
-    return false;
+
+    std::stringstream gateReport;
+    bool gatePassed = _gate.finish(_memory.hasAllocationCounts(), _memory.totalAllocations(), gateReport);
+    streamlog_out(MESSAGE)<<gateReport.str();
+    if ( !gatePassed ) throw EVENT::Exception("DecayChainDrawer: regression gate failed, see report above");
 }
 
 
+void DecayChainDrawer::buildDetectorRegions(){
+    using namespace dd4hep;
+    using namespace dd4hep::rec;
+    Detector& detector = Detector::getInstance();
+
+    // trackers layer by layer, lengths converted from DD4hep units to mm
+    for(auto& element : detector.detectors(DetType::TRACKER | DetType::BARREL, DetType::AUXILIARY)){
+        std::string name = element.name();
+        if (ZPlanarData* planar = element.extension<ZPlanarData>(false)){
+            for(size_t i=0; i < planar->layers.size(); ++i){
+                const ZPlanarData::LayerLayout& layer = planar->layers[i];
+                double rMin = std::min(layer.distanceSupport, layer.distanceSensitive);
+                _detectorRegions.add(name + " " + std::to_string(i+1), rMin/dd4hep::mm, layer.zHalfSensitive/dd4hep::mm);
+            }
+        }
+        else if (FixedPadSizeTPCData* tpc = element.extension<FixedPadSizeTPCData>(false)){
+            _detectorRegions.add(name, tpc->rMin/dd4hep::mm, tpc->zHalf/dd4hep::mm);
+        }
+    }
+    // calorimeters as a whole: extent is rMin, rMax, zMin, zMax
+    for(auto& element : detector.detectors(DetType::CALORIMETER | DetType::BARREL, DetType::AUXILIARY)){
+        if (LayeredCalorimeterData* calorimeter = element.extension<LayeredCalorimeterData>(false)){
+            _detectorRegions.add(element.name(), calorimeter->extent[0]/dd4hep::mm, calorimeter->extent[3]/dd4hep::mm);
+        }
+    }
+    _detectorRegions.finish();
+    for(int i=0; i < _detectorRegions.size(); ++i) streamlog_out(DEBUG)<<"Detector region "<<i<<": "<<_detectorRegions.name(i)<<std::endl;
+}
 
-std::map<int, std::string> DecayChainDrawer::getPdgNamesMap(){
-    std::map<int, std::string> pdg2str;
-
-    pdg2str[92] = "Hadronization";
-    // leptons
-    pdg2str[11] = "e<SUP>-</SUP>";
-    pdg2str[-11] = "e<SUP>+</SUP>";
-    pdg2str[12] = "&nu;<SUB>e</SUB>";
-    pdg2str[-12] = "&nu;<SUB>e</SUB>";
-    pdg2str[13] = "&mu;<SUP>-</SUP>";
-    pdg2str[-13] = "&mu;<SUP>+</SUP>";
-    pdg2str[14] = "&nu;<SUB>&mu;</SUB>";
-    pdg2str[-14] = "&nu;<SUB>&mu;</SUB>";
-    pdg2str[15] = "&tau;<SUP>-</SUP>";
-    pdg2str[-15] = "&tau;<SUP>+</SUP>";
-    pdg2str[16] = "&nu;<SUB>&tau;</SUB>";
-    pdg2str[-16] = "&nu;<SUB>&tau;</SUB>";
-    //Gauge and Higgs Boson
-    pdg2str[22] = "&gamma;";
-    pdg2str[23] = "Z<SUP>0</SUP>";
-    pdg2str[24] = "W<SUP>+</SUP>";
-    pdg2str[-24] = "W<SUP>-</SUP>";
-    // Higgs?
-    // light mesons I=1
-    pdg2str[111] = "&pi;<SUP>0</SUP>";
-    pdg2str[-111] = "&pi;<SUP>0</SUP>";
-    pdg2str[211] = "&pi;<SUP>+</SUP>";
-    pdg2str[-211] = "&pi;<SUP>-</SUP>";
-    pdg2str[9000111] = "a<SUB>0</SUB>(980)<SUP>0</SUP>";
-    pdg2str[-9000111] = "a<SUB>0</SUB>(980)<SUP>0</SUP>";
-    pdg2str[9000211] = "a<SUB>0</SUB>(980)<SUP>+</SUP>";
-    pdg2str[-9000211] = "a<SUB>0</SUB>(980)<SUP>-</SUP>";
-    pdg2str[100111] = "&pi;(1300)<SUP>0</SUP>";
-    pdg2str[-100111] = "&pi;(1300)<SUP>0</SUP>";
-    pdg2str[100211] = "&pi;(1300)<SUP>+</SUP>";
-    pdg2str[-100211] = "&pi;(1300)<SUP>-</SUP>";
-    pdg2str[10111] = "a<SUB>0</SUB>(1450)<SUP>0</SUP>";
-    pdg2str[-10111] = "a<SUB>0</SUB>(1450)<SUP>0</SUP>";
-    pdg2str[10211] = "a<SUB>0</SUB>(1450)<SUP>+</SUP>";
-    pdg2str[-10211] = "a<SUB>0</SUB>(1450)<SUP>-</SUP>";
-    pdg2str[9010111] = "&pi;(1800)<SUP>0</SUP>";
-    pdg2str[-9010111] = "&pi;(1800)<SUP>0</SUP>";
-    pdg2str[9010211] = "&pi;(1800)<SUP>+</SUP>";
-    pdg2str[-9010211] = "&pi;(1800)<SUP>-</SUP>";
-    pdg2str[113] = "&rho;(770)<SUP>0</SUP>";
-    pdg2str[-113] = "&rho;(770)<SUP>0</SUP>";
-    pdg2str[213] = "&rho;(770)<SUP>+</SUP>";
-    pdg2str[-213] = "&rho;(770)<SUP>-</SUP>";
-    pdg2str[10113] = "b<SUB>1</SUB>(1235)<SUP>0</SUP>";
-    pdg2str[-10113] = "b<SUB>1</SUB>(1235)<SUP>0</SUP>";
-    pdg2str[10213] = "b<SUB>1</SUB>(1235)<SUP>+</SUP>";
-    pdg2str[-10213] = "b<SUB>1</SUB>(1235)<SUP>-</SUP>";
-    pdg2str[20113] = "a<SUB>1</SUB>(1260)<SUP>0</SUP>";
-    pdg2str[-20113] = "a<SUB>1</SUB>(1260)<SUP>0</SUP>";
-    pdg2str[20213] = "a<SUB>1</SUB>(1260)<SUP>+</SUP>";
-    pdg2str[-20213] = "a<SUB>1</SUB>(1260)<SUP>-</SUP>";
-    pdg2str[9000113] = "&pi;<SUB>1</SUB>(1400)<SUP>0</SUP>";
-    pdg2str[-9000113] = "&pi;<SUB>1</SUB>(1400)<SUP>0</SUP>";
-    pdg2str[9000213] = "&pi;<SUB>1</SUB>(1400)<SUP>+</SUP>";
-    pdg2str[-9000213] = "&pi;<SUB>1</SUB>(1400)<SUP>-</SUP>";
-    pdg2str[100113] = "&rho;(1450)<SUP>0</SUP>";
-    pdg2str[-100113] = "&rho;(1450)<SUP>0</SUP>";
-    pdg2str[100213] = "&rho;(1450)<SUP>+</SUP>";
-    pdg2str[-100213] = "&rho;(1450)<SUP>-</SUP>";
-    pdg2str[9010113] = "&pi;<SUB>1</SUB>(1600)<SUP>0</SUP>";
-    pdg2str[-9010113] = "&pi;<SUB>1</SUB>(1600)<SUP>0</SUP>";
-    pdg2str[9010213] = "&pi;<SUB>1</SUB>(1600)<SUP>+</SUP>";
-    pdg2str[-9010213] = "&pi;<SUB>1</SUB>(1600)<SUP>-</SUP>";
-    pdg2str[9020113] = "a<SUB>1</SUB>(1640)<SUP>0</SUP>";
-    pdg2str[-9020113] = "a<SUB>1</SUB>(1640)<SUP>0</SUP>";
-    pdg2str[9020213] = "a<SUB>1</SUB>(1640)<SUP>+</SUP>";
-    pdg2str[-9020213] = "a<SUB>1</SUB>(1640)<SUP>-</SUP>";
-    pdg2str[30113] = "&rho;(1700)<SUP>0</SUP>";
-    pdg2str[-30113] = "&rho;(1700)<SUP>0</SUP>";
-    pdg2str[30213] = "&rho;(1700)<SUP>+</SUP>";
-    pdg2str[-30213] = "&rho;(1700)<SUP>-</SUP>";
-    pdg2str[9030113] = "&rho;(1900)<SUP>0</SUP>";
-    pdg2str[-9030113] = "&rho;(1900)<SUP>0</SUP>";
-    pdg2str[9030213] = "&rho;(1900)<SUP>+</SUP>";
-    pdg2str[-9030213] = "&rho;(1900)<SUP>-</SUP>";
-    pdg2str[9040113] = "&rho;(2150)<SUP>0</SUP>";
-    pdg2str[-9040113] = "&rho;(2150)<SUP>0</SUP>";
-    pdg2str[9040213] = "&rho;(2150)<SUP>+</SUP>";
-    pdg2str[-9040213] = "&rho;(2150)<SUP>-</SUP>";
-    pdg2str[115] = "a<SUB>2</SUB>(1320)<SUP>0</SUP>";
-    pdg2str[-115] = "a<SUB>2</SUB>(1320)<SUP>0</SUP>";
-    pdg2str[215] = "a<SUB>2</SUB>(1320)<SUP>+</SUP>";
-    pdg2str[-215] = "a<SUB>2</SUB>(1320)<SUP>-</SUP>";
-    pdg2str[10115] = "&pi;<SUB>2</SUB>(1670)<SUP>0</SUP>";
-    pdg2str[-10115] = "&pi;<SUB>2</SUB>(1670)<SUP>0</SUP>";
-    pdg2str[10215] = "&pi;<SUB>2</SUB>(1670)<SUP>+</SUP>";
-    pdg2str[-10215] = "&pi;<SUB>2</SUB>(1670)<SUP>-</SUP>";
-    pdg2str[9000115] = "a<SUB>2</SUB>(1700)<SUP>0</SUP>";
-    pdg2str[-9000115] = "a<SUB>2</SUB>(1700)<SUP>0</SUP>";
-    pdg2str[9000215] = "a<SUB>2</SUB>(1700)<SUP>+</SUP>";
-    pdg2str[-9000215] = "a<SUB>2</SUB>(1700)<SUP>-</SUP>";
-    pdg2str[9010115] = "&pi;<SUB>2</SUB>(2100)<SUP>0</SUP>";
-    pdg2str[-9010115] = "&pi;<SUB>2</SUB>(2100)<SUP>0</SUP>";
-    pdg2str[9010215] = "&pi;<SUB>2</SUB>(2100)<SUP>+</SUP>";
-    pdg2str[-9010215] = "&pi;<SUB>2</SUB>(2100)<SUP>-</SUP>";
-    pdg2str[117] = "&rho;<SUB>3</SUB>(1690)<SUP>0</SUP>";
-    pdg2str[-117] = "&rho;<SUB>3</SUB>(1690)<SUP>0</SUP>";
-    pdg2str[217] = "&rho;<SUB>3</SUB>(1690)<SUP>+</SUP>";
-    pdg2str[-217] = "&rho;<SUB>3</SUB>(1690)<SUP>-</SUP>";
-    pdg2str[9000117] = "&rho;<SUB>3</SUB>(1990)<SUP>0</SUP>";
-    pdg2str[-9000117] = "&rho;<SUB>3</SUB>(1990)<SUP>0</SUP>";
-    pdg2str[9000217] = "&rho;<SUB>3</SUB>(1990)<SUP>+</SUP>";
-    pdg2str[-9000217] = "&rho;<SUB>3</SUB>(1990)<SUP>-</SUP>";
-    pdg2str[9010117] = "&rho;<SUB>3</SUB>(2250)<SUP>0</SUP>";
-    pdg2str[-9010117] = "&rho;<SUB>3</SUB>(2250)<SUP>0</SUP>";
-    pdg2str[9010217] = "&rho;<SUB>3</SUB>(2250)<SUP>+</SUP>";
-    pdg2str[-9010217] = "&rho;<SUB>3</SUB>(2250)<SUP>-</SUP>";
-    pdg2str[119] = "a<SUB>4</SUB>(2040)<SUP>0</SUP>";
-    pdg2str[-119] = "a<SUB>4</SUB>(2040)<SUP>0</SUP>";
-    pdg2str[219] = "a<SUB>4</SUB>(2040)<SUP>+</SUP>";
-    pdg2str[-219] = "a<SUB>4</SUB>(2040)<SUP>-</SUP>";
-
-
-    // light mesons I=0
-    pdg2str[221] = "&eta;";
-    pdg2str[-221] = "&eta;";
-    pdg2str[331] = "&eta;\'";
-    pdg2str[-331] = "&eta;\'";
-    pdg2str[9000221] = "f<SUB>0</SUB>(600)";
-    pdg2str[-9000221] = "f<SUB>0</SUB>(600)";
-    pdg2str[9010221] = "f<SUB>0</SUB>(980)";
-    pdg2str[-9010221] = "f<SUB>0</SUB>(980)";
-    pdg2str[100221] = "&eta;(1295)";
-    pdg2str[-100221] = "&eta;(1295)";
-    pdg2str[10221] = "f<SUB>0</SUB>(1370)";
-    pdg2str[-10221] = "f<SUB>0</SUB>(1370)";
-    pdg2str[9020221] = "&eta;(1405)";
-    pdg2str[-9020221] = "&eta;(1405)";
-    pdg2str[100331] = "&eta;(1475)";
-    pdg2str[-100331] = "&eta;(1475)";
-    pdg2str[9030221] = "f<SUB>0</SUB>(1500)";
-    pdg2str[-9030221] = "f<SUB>0</SUB>(1500)";
-    pdg2str[10331] = "f<SUB>0</SUB>(1710)";
-    pdg2str[-10331] = "f<SUB>0</SUB>(1710)";
-    pdg2str[9040221] = "&eta;(1760)";
-    pdg2str[-9040221] = "&eta;(1760)";
-    pdg2str[9050221] = "f<SUB>0</SUB>(2020)";
-    pdg2str[-9050221] = "f<SUB>0</SUB>(2020)";
-    pdg2str[9060221] = "f<SUB>0</SUB>(2100)";
-    pdg2str[-9060221] = "f<SUB>0</SUB>(2100)";
-    pdg2str[9070221] = "f<SUB>0</SUB>(2200)";
-    pdg2str[-9070221] = "f<SUB>0</SUB>(2200)";
-    pdg2str[9080221] = "&eta;(2225)";
-    pdg2str[-9080221] = "&eta;(2225)";
-    pdg2str[223] = "&omega;";
-    pdg2str[-223] = "&omega;";
-    pdg2str[333] = "&phi;";
-    pdg2str[-333] = "&phi;";
-    pdg2str[10223] = "h<SUB>1</SUB>(1170)";
-    pdg2str[-10223] = "h<SUB>1</SUB>(1170)";
-    pdg2str[20223] = "f<SUB>1</SUB>(1285)";
-    pdg2str[-20223] = "f<SUB>1</SUB>(1285)";
-    pdg2str[10333] = "h<SUB>1</SUB>(1380)";
-    pdg2str[-10333] = "h<SUB>1</SUB>(1380)";
-    pdg2str[20333] = "f<SUB>1</SUB>(1420)";
-    pdg2str[-20333] = "f<SUB>1</SUB>(1420)";
-    pdg2str[100223] = "&omega;(1420)";
-    pdg2str[-100223] = "&omega;(1420)";
-    pdg2str[9000223] = "f<SUB>1</SUB>(1510)";
-    pdg2str[-9000223] = "f<SUB>1</SUB>(1510)";
-    pdg2str[9010223] = "h<SUB>1</SUB>(1595)";
-    pdg2str[-9010223] = "h<SUB>1</SUB>(1595)";
-    pdg2str[30223] = "&omega;(1650)";
-    pdg2str[-30223] = "&omega;(1650)";
-    pdg2str[100333] = "&phi;(1680)";
-    pdg2str[-100333] = "&phi;(1680)";
-    pdg2str[225] = "f<SUB>2</SUB>(1270)";
-    pdg2str[-225] = "f<SUB>2</SUB>(1270)";
-    pdg2str[9000225] = "f<SUB>2</SUB>(1430)";
-    pdg2str[-9000225] = "f<SUB>2</SUB>(1430)";
-    pdg2str[335] = "f<SUB>2</SUB>\'(1525)";
-    pdg2str[-335] = "f<SUB>2</SUB>\'(1525)";
-    pdg2str[9010225] = "f<SUB>2</SUB>(1565)";
-    pdg2str[-9010225] = "f<SUB>2</SUB>(1565)";
-    pdg2str[9020225] = "f<SUB>2</SUB>(1640)";
-    pdg2str[-9020225] = "f<SUB>2</SUB>(1640)";
-    pdg2str[10225] = "&eta;<SUB>2</SUB>(1645)";
-    pdg2str[-10225] = "&eta;<SUB>2</SUB>(1645)";
-    pdg2str[9030225] = "f<SUB>2</SUB>(1810)";
-    pdg2str[-9030225] = "f<SUB>2</SUB>(1810)";
-    pdg2str[10335] = "&eta;<SUB>2</SUB>(1870)";
-    pdg2str[-10335] = "&eta;<SUB>2</SUB>(1870)";
-    pdg2str[9040225] = "f<SUB>2</SUB>(1910)";
-    pdg2str[-9040225] = "f<SUB>2</SUB>(1910)";
-    pdg2str[9050225] = "f<SUB>2</SUB>(1950)";
-    pdg2str[-9050225] = "f<SUB>2</SUB>(1950)";
-    pdg2str[9060225] = "f<SUB>2</SUB>(2010)";
-    pdg2str[-9060225] = "f<SUB>2</SUB>(2010)";
-    pdg2str[9070225] = "f<SUB>2</SUB>(2150)";
-    pdg2str[-9070225] = "f<SUB>2</SUB>(2150)";
-    pdg2str[9080225] = "f<SUB>2</SUB>(2300)";
-    pdg2str[-9080225] = "f<SUB>2</SUB>(2300)";
-    pdg2str[9090225] = "f<SUB>2</SUB>(2340)";
-    pdg2str[-9090225] = "f<SUB>2</SUB>(2340)";
-    pdg2str[227] = "&omega;<SUB>3</SUB>(1670)";
-    pdg2str[-227] = "&omega;<SUB>3</SUB>(1670)";
-    pdg2str[337] = "&phi;<SUB>3</SUB>(1850)";
-    pdg2str[-337] = "&phi;<SUB>3</SUB>(1850)";
-    pdg2str[229] = "f<SUB>4</SUB>(2050)";
-    pdg2str[-229] = "f<SUB>4</SUB>(2050)";
-    pdg2str[9000229] = "f<SUB>J</SUB>(2220)";
-    pdg2str[-9000229] = "f<SUB>J</SUB>(2220)";
-    pdg2str[9010229] = "f<SUB>4</SUB>(2300)";
-    pdg2str[-9010229] = "f<SUB>4</SUB>(2300)";
-    
-    // strange mesons
-    pdg2str[130] = "K<SUB>L</SUB><SUP>0</SUP>";
-    pdg2str[-130] = "K<SUB>L</SUB><SUP>0</SUP>";
-    pdg2str[310] = "K<SUB>S</SUB><SUP>0</SUP>";
-    pdg2str[-310] = "K<SUB>S</SUB><SUP>0</SUP>";
-    pdg2str[311] = "K<SUP>0</SUP>";
-    pdg2str[-311] = "K<SUP>0</SUP>";
-    pdg2str[321] = "K<SUP>+</SUP>";
-    pdg2str[-321] = "K<SUP>-</SUP>";
-    pdg2str[9000311] = "K<SUB>0</SUB><SUP>*</SUP>(800)<SUP>0</SUP>";
-    pdg2str[-9000311] = "K<SUB>0</SUB><SUP>*</SUP>(800)<SUP>0</SUP>";
-    pdg2str[9000321] = "K<SUB>0</SUB><SUP>*</SUP>(800)<SUP>+</SUP>";
-    pdg2str[-9000321] = "K<SUB>0</SUB><SUP>*</SUP>(800)<SUP>-</SUP>";
-    pdg2str[10311] = "K<SUB>0</SUB><SUP>*</SUP>(1430)<SUP>0</SUP>";
-    pdg2str[-10311] = "K<SUB>0</SUB><SUP>*</SUP>(1430)<SUP>0</SUP>";
-    pdg2str[10321] = "K<SUB>0</SUB><SUP>*</SUP>(1430)<SUP>+</SUP>";
-    pdg2str[-10321] = "K<SUB>0</SUB><SUP>*</SUP>(1430)<SUP>-</SUP>";
-    pdg2str[100311] = "K(1460)<SUP>0</SUP>";
-    pdg2str[-100311] = "K(1460)<SUP>0</SUP>";
-    pdg2str[100321] = "K(1460)<SUP>+</SUP>";
-    pdg2str[-100321] = "K(1460)<SUP>-</SUP>";
-    pdg2str[9010311] = "K(1830)<SUP>0</SUP>";
-    pdg2str[-9010311] = "K(1830)<SUP>0</SUP>";
-    pdg2str[9010321] = "K(1830)<SUP>+</SUP>";
-    pdg2str[-9010321] = "K(1830)<SUP>-</SUP>";
-    pdg2str[9020311] = "K<SUB>0</SUB><SUP>*</SUP>(1950)<SUP>0</SUP>";
-    pdg2str[-9020311] = "K<SUB>0</SUB><SUP>*</SUP>(1950)<SUP>0</SUP>";
-    pdg2str[9020321] = "K<SUB>0</SUB><SUP>*</SUP>(1950)<SUP>+</SUP>";
-    pdg2str[-9020321] = "K<SUB>0</SUB><SUP>*</SUP>(1950)<SUP>-</SUP>";
-    pdg2str[313] = "K<SUP>*</SUP>(892)<SUP>0</SUP>";
-    pdg2str[-313] = "K<SUP>*</SUP>(892)<SUP>0</SUP>";
-    pdg2str[323] = "K<SUP>*</SUP>(892)<SUP>+</SUP>";
-    pdg2str[-323] = "K<SUP>*</SUP>(892)<SUP>-</SUP>";
-    pdg2str[10313] = "K<SUB>1</SUB>(1270)<SUP>0</SUP>";
-    pdg2str[-10313] = "K<SUB>1</SUB>(1270)<SUP>0</SUP>";
-    pdg2str[10323] = "K<SUB>1</SUB>(1270)<SUP>+</SUP>";
-    pdg2str[-10323] = "K<SUB>1</SUB>(1270)<SUP>-</SUP>";
-    pdg2str[20313] = "K<SUB>1</SUB>(1400)<SUP>0</SUP>";
-    pdg2str[-20313] = "K<SUB>1</SUB>(1400)<SUP>0</SUP>";
-    pdg2str[20323] = "K<SUB>1</SUB>(1400)<SUP>+</SUP>";
-    pdg2str[-20323] = "K<SUB>1</SUB>(1400)<SUP>-</SUP>";
-    pdg2str[100313] = "K<SUP>*</SUP>(1410)<SUP>0</SUP>";
-    pdg2str[-100313] = "K<SUP>*</SUP>(1410)<SUP>0</SUP>";
-    pdg2str[100323] = "K<SUP>*</SUP>(1410)<SUP>+</SUP>";
-    pdg2str[-100323] = "K<SUP>*</SUP>(1410)<SUP>-</SUP>";
-    pdg2str[9000313] = "K<SUB>1</SUB>(1650)<SUP>0</SUP>";
-    pdg2str[-9000313] = "K<SUB>1</SUB>(1650)<SUP>0</SUP>";
-    pdg2str[9000323] = "K<SUB>1</SUB>(1650)<SUP>+</SUP>";
-    pdg2str[-9000323] = "K<SUB>1</SUB>(1650)<SUP>-</SUP>";
-    pdg2str[30313] = "K<SUP>*</SUP>(1680)<SUP>0</SUP>";
-    pdg2str[-30313] = "K<SUP>*</SUP>(1680)<SUP>0</SUP>";
-    pdg2str[30323] = "K<SUP>*</SUP>(1680)<SUP>+</SUP>";
-    pdg2str[-30323] = "K<SUP>*</SUP>(1680)<SUP>-</SUP>";
-    pdg2str[315] = "K<SUB>2</SUB><SUP>*</SUP>(1430)<SUP>0</SUP>";
-    pdg2str[-315] = "K<SUB>2</SUB><SUP>*</SUP>(1430)<SUP>0</SUP>";
-    pdg2str[325] = "K<SUB>2</SUB><SUP>*</SUP>(1430)<SUP>+</SUP>";
-    pdg2str[-325] = "K<SUB>2</SUB><SUP>*</SUP>(1430)<SUP>-</SUP>";
-    pdg2str[9000315] = "K<SUB>2</SUB>(1580)<SUP>0</SUP>";
-    pdg2str[-9000315] = "K<SUB>2</SUB>(1580)<SUP>0</SUP>";
-    pdg2str[9000325] = "K<SUB>2</SUB>(1580)<SUP>+</SUP>";
-    pdg2str[-9000325] = "K<SUB>2</SUB>(1580)<SUP>-</SUP>";
-    pdg2str[10315] = "K<SUB>2</SUB>(1770)<SUP>0</SUP>";
-    pdg2str[-10315] = "K<SUB>2</SUB>(1770)<SUP>0</SUP>";
-    pdg2str[10325] = "K<SUB>2</SUB>(1770)<SUP>+</SUP>";
-    pdg2str[-10325] = "K<SUB>2</SUB>(1770)<SUP>-</SUP>";
-    pdg2str[20315] = "K<SUB>2</SUB>(1820)<SUP>0</SUP>";
-    pdg2str[-20315] = "K<SUB>2</SUB>(1820)<SUP>0</SUP>";
-    pdg2str[20325] = "K<SUB>2</SUB>(1820)<SUP>+</SUP>";
-    pdg2str[-20325] = "K<SUB>2</SUB>(1820)<SUP>-</SUP>";
-    pdg2str[9010315] = "K<SUB>2</SUB><SUP>*</SUP>(1980)<SUP>0</SUP>";
-    pdg2str[-9010315] = "K<SUB>2</SUB><SUP>*</SUP>(1980)<SUP>0</SUP>";
-    pdg2str[9010325] = "K<SUB>2</SUB><SUP>*</SUP>(1980)<SUP>+</SUP>";
-    pdg2str[-9010325] = "K<SUB>2</SUB><SUP>*</SUP>(1980)<SUP>-</SUP>";
-    pdg2str[9020315] = "K<SUB>2</SUB>(2250)<SUP>0</SUP>";
-    pdg2str[-9020315] = "K<SUB>2</SUB>(2250)<SUP>0</SUP>";
-    pdg2str[9020325] = "K<SUB>2</SUB>(2250)<SUP>+</SUP>";
-    pdg2str[-9020325] = "K<SUB>2</SUB>(2250)<SUP>-</SUP>";
-    pdg2str[317] = "K<SUB>3</SUB><SUP>*</SUP>(1780)<SUP>0</SUP>";
-    pdg2str[-317] = "K<SUB>3</SUB><SUP>*</SUP>(1780)<SUP>0</SUP>";
-    pdg2str[327] = "K<SUB>3</SUB><SUP>*</SUP>(1780)<SUP>+</SUP>";
-    pdg2str[-327] = "K<SUB>3</SUB><SUP>*</SUP>(1780)<SUP>-</SUP>";
-    pdg2str[9010317] = "K<SUB>3</SUB>(2320)<SUP>0</SUP>";
-    pdg2str[-9010317] = "K<SUB>3</SUB>(2320)<SUP>0</SUP>";
-    pdg2str[9010327] = "K<SUB>3</SUB>(2320)<SUP>+</SUP>";
-    pdg2str[-9010327] = "K<SUB>3</SUB>(2320)<SUP>-</SUP>";
-    pdg2str[319] = "K<SUB>4</SUB><SUP>*</SUP>(2045)<SUP>0</SUP>";
-    pdg2str[-319] = "K<SUB>4</SUB><SUP>*</SUP>(2045)<SUP>0</SUP>";
-    pdg2str[329] = "K<SUB>4</SUB><SUP>*</SUP>(2045)<SUP>+</SUP>";
-    pdg2str[-329] = "K<SUB>4</SUB><SUP>*</SUP>(2045)<SUP>-</SUP>";
-    pdg2str[9000319] = "K<SUB>4</SUB>(2500)<SUP>0</SUP>";
-    pdg2str[-9000319] = "K<SUB>4</SUB>(2500)<SUP>0</SUP>";
-    pdg2str[9000329] = "K<SUB>4</SUB>(2500)<SUP>+</SUP>";
-    pdg2str[-9000329] = "K<SUB>4</SUB>(2500)<SUP>-</SUP>";
-
-
-    //charmed mesons
-    pdg2str[411] = "D<SUP>+</SUP>";
-    pdg2str[-411] = "D<SUP>-</SUP>";
-    pdg2str[421] = "D<SUP>0</SUP>";
-    pdg2str[-421] = "D<SUP>0</SUP>";
-    pdg2str[10411] = "D<SUB>0</SUB><SUP>*</SUP>(2400)<SUP>+</SUP>";
-    pdg2str[-10411] = "D<SUB>0</SUB><SUP>*</SUP>(2400)<SUP>-</SUP>";
-    pdg2str[10421] = "D<SUB>0</SUB><SUP>*</SUP>(2400)<SUP>0</SUP>";
-    pdg2str[-10421] = "D<SUB>0</SUB><SUP>*</SUP>(2400)<SUP>0</SUP>";
-    pdg2str[413] = "D<SUP>*</SUP>(2010)<SUP>+</SUP>";
-    pdg2str[-413] = "D<SUP>*</SUP>(2010)<SUP>-</SUP>";
-    pdg2str[423] = "D<SUP>*</SUP>(2007)<SUP>0</SUP>";
-    pdg2str[-423] = "D<SUP>*</SUP>(2007)<SUP>0</SUP>";
-    pdg2str[10413] = "D<SUB>1</SUB>(2420)<SUP>+</SUP>";
-    pdg2str[-10413] = "D<SUB>1</SUB>(2420)<SUP>-</SUP>";
-    pdg2str[10423] = "D<SUB>1</SUB>(2420)<SUP>0</SUP>";
-    pdg2str[-10423] = "D<SUB>1</SUB>(2420)<SUP>0</SUP>";
-    pdg2str[20413] = "D<SUB>1</SUB>(H)<SUP>+</SUP>";
-    pdg2str[-20413] = "D<SUB>1</SUB>(H)<SUP>-</SUP>";
-    pdg2str[20423] = "D<SUB>1</SUB>(2430)<SUP>0</SUP>";
-    pdg2str[-20423] = "D<SUB>1</SUB>(2430)<SUP>0</SUP>";
-    pdg2str[415] = "D<SUB>2</SUB><SUP>*</SUP>(2460)<SUP>+</SUP>";
-    pdg2str[-415] = "D<SUB>2</SUB><SUP>*</SUP>(2460)<SUP>-</SUP>";
-    pdg2str[425] = "D<SUB>2</SUB><SUP>*</SUP>(2460)<SUP>0</SUP>";
-    pdg2str[-425] = "D<SUB>2</SUB><SUP>*</SUP>(2460)<SUP>0</SUP>";
-    pdg2str[431] = "D<SUB>s</SUB><SUP>+</SUP>";
-    pdg2str[-431] = "D<SUB>s</SUB><SUP>-</SUP>";
-    pdg2str[10431] = "D<SUB>s0</SUB><SUP>*</SUP>(2317)<SUP>+</SUP>";
-    pdg2str[-10431] = "D<SUB>s0</SUB><SUP>*</SUP>(2317)<SUP>-</SUP>";
-    pdg2str[433] = "D<SUB>s</SUB><SUP>*+</SUP>";
-    pdg2str[-433] = "D<SUB>s</SUB><SUP>*-</SUP>";
-    pdg2str[10433] = "D<SUB>s1</SUB>(2536)<SUP>+</SUP>";
-    pdg2str[-10433] = "D<SUB>s1</SUB>(2536)<SUP>-</SUP>";
-    pdg2str[20433] = "D<SUB>s1</SUB>(2460)<SUP>+</SUP>";
-    pdg2str[-20433] = "D<SUB>s1</SUB>(2460)<SUP>-</SUP>";
-    pdg2str[435] = "D<SUB>s2</SUB><SUP>*</SUP>(2573)<SUP>+</SUP>";
-    pdg2str[-435] = "D<SUB>s2</SUB><SUP>*</SUP>(2573)<SUP>-</SUP>";
-
-    //bottom mesons
-    pdg2str[511] = "B<SUP>0</SUP>";
-    pdg2str[-511] = "B<SUP>0</SUP>";
-    pdg2str[521] = "B<SUP>+</SUP>";
-    pdg2str[-521] = "B<SUP>-</SUP>";
-    pdg2str[10511] = "B<SUB>0</SUB><SUP>*0</SUP>";
-    pdg2str[-10511] = "B<SUB>0</SUB><SUP>*0</SUP>";
-    pdg2str[10521] = "B<SUB>0</SUB><SUP>*+</SUP>";
-    pdg2str[-10521] = "B<SUB>0</SUB><SUP>*-</SUP>";
-    pdg2str[513] = "B<SUP>*0</SUP>";
-    pdg2str[-513] = "B<SUP>*0</SUP>";
-    pdg2str[523] = "B<SUP>*+</SUP>";
-    pdg2str[-523] = "B<SUP>*-</SUP>";
-    pdg2str[10513] = "B<SUB>1</SUB>(L)<SUP>0</SUP>";
-    pdg2str[-10513] = "B<SUB>1</SUB>(L)<SUP>0</SUP>";
-    pdg2str[10523] = "B<SUB>1</SUB>(L)<SUP>+</SUP>";
-    pdg2str[-10523] = "B<SUB>1</SUB>(L)<SUP>-</SUP>";
-    pdg2str[20513] = "B<SUB>1</SUB>(H)<SUP>0</SUP>";
-    pdg2str[-20513] = "B<SUB>1</SUB>(H)<SUP>0</SUP>";
-    pdg2str[20523] = "B<SUB>1</SUB>(H)<SUP>+</SUP>";
-    pdg2str[-20523] = "B<SUB>1</SUB>(H)<SUP>-</SUP>";
-    pdg2str[515] = "B<SUB>2</SUB><SUP>*0</SUP>";
-    pdg2str[-515] = "B<SUB>2</SUB><SUP>*0</SUP>";
-    pdg2str[525] = "B<SUB>2</SUB><SUP>*+</SUP>";
-    pdg2str[-525] = "B<SUB>2</SUB><SUP>*-</SUP>";
-    pdg2str[531] = "B<SUB>s</SUB><SUP>0</SUP>";
-    pdg2str[-531] = "B<SUB>s</SUB><SUP>0</SUP>";
-    pdg2str[10531] = "B<SUB>s0</SUB><SUP>*0</SUP>";
-    pdg2str[-10531] = "B<SUB>s0</SUB><SUP>*0</SUP>";
-    pdg2str[533] = "B<SUB>s</SUB><SUP>*0</SUP>";
-    pdg2str[-533] = "B<SUB>s</SUB><SUP>*0</SUP>";
-    pdg2str[10533] = "B<SUB>s1</SUB>(L)<SUP>0</SUP>";
-    pdg2str[-10533] = "B<SUB>s1</SUB>(L)<SUP>0</SUP>";
-    pdg2str[20533] = "B<SUB>s1</SUB>(H)<SUP>0</SUP>";
-    pdg2str[-20533] = "B<SUB>s1</SUB>(H)<SUP>0</SUP>";
-    pdg2str[535] = "B<SUB>s2</SUB><SUP>*0</SUP>";
-    pdg2str[-535] = "B<SUB>s2</SUB><SUP>*0</SUP>";
-    pdg2str[541] = "B<SUB>c</SUB><SUP>+</SUP>";
-    pdg2str[-541] = "B<SUB>c</SUB><SUP>-</SUP>";
-    pdg2str[10541] = "B<SUB>c0</SUB><SUP>*+</SUP>";
-    pdg2str[-10541] = "B<SUB>c0</SUB><SUP>*-</SUP>";
-    pdg2str[543] = "B<SUB>c</SUB><SUP>*+</SUP>";
-    pdg2str[-543] = "B<SUB>c</SUB><SUP>*-</SUP>";
-    pdg2str[10543] = "B<SUB>c1</SUB>(L)<SUP>+</SUP>";
-    pdg2str[-10543] = "B<SUB>c1</SUB>(L)<SUP>-</SUP>";
-    pdg2str[20543] = "B<SUB>c1</SUB>(H)<SUP>+</SUP>";
-    pdg2str[-20543] = "B<SUB>c1</SUB>(H)<SUP>-</SUP>";
-    pdg2str[545] = "B<SUB>c2</SUB><SUP>+</SUP>";
-    pdg2str[-545] = "B<SUB>c2</SUB><SUP>-</SUP>";
-
-    //cc mesons
-    pdg2str[441] = "&eta;<SUB>c</SUB>(1S)";
-    pdg2str[-441] = "&eta;<SUB>c</SUB>(1S)";
-    pdg2str[10441] = "&chi;<SUB>c0</SUB>(1P)";
-    pdg2str[-10441] = "&chi;<SUB>c0</SUB>(1P)";
-    pdg2str[100441] = "&eta;<SUB>c</SUB>(2S)";
-    pdg2str[-100441] = "&eta;<SUB>c</SUB>(2S)";
-    pdg2str[443] = "J/&psi;(1S)";
-    pdg2str[-443] = "J/&psi;(1S)";
-    pdg2str[10443] = "h<SUB>c</SUB>(1P)";
-    pdg2str[-10443] = "h<SUB>c</SUB>(1P)";
-    pdg2str[20443] = "&chi;<SUB>c1</SUB>(1P)";
-    pdg2str[-20443] = "&chi;<SUB>c1</SUB>(1P)";
-    pdg2str[100443] = "&psi;(2S)";
-    pdg2str[-100443] = "&psi;(2S)";
-    pdg2str[30443] = "&psi;(3770)";
-    pdg2str[-30443] = "&psi;(3770)";
-    pdg2str[9000443] = "&psi;(4040)";
-    pdg2str[-9000443] = "&psi;(4040)";
-    pdg2str[9010443] = "&psi;(4160)";
-    pdg2str[-9010443] = "&psi;(4160)";
-    pdg2str[9020443] = "&psi;(4415)";
-    pdg2str[-9020443] = "&psi;(4415)";
-    pdg2str[445] = "&chi;<SUB>c2</SUB>(1P)";
-    pdg2str[-445] = "&chi;<SUB>c2</SUB>(1P)";
-    pdg2str[100445] = "&chi;<SUB>c2</SUB>(2P)";
-    pdg2str[-100445] = "&chi;<SUB>c2</SUB>(2P)";
-
-    //light baryons
-    pdg2str[2212] = "p<SUP>+</SUP>";
-    pdg2str[-2212] = "p<SUP>-</SUP>";
-    pdg2str[2112] = "n";
-    pdg2str[-2112] = "n";
-    pdg2str[2224] = "&Delta;<SUP>++</SUP>";
-    pdg2str[-2224] = "&Delta;<SUP>--</SUP>";
-    pdg2str[2214] = "&Delta;<SUP>+</SUP>";
-    pdg2str[-2214] = "&Delta;<SUP>+</SUP>";
-    pdg2str[2114] = "&Delta;<SUP>0</SUP>";
-    pdg2str[-2114] = "&Delta;<SUP>0</SUP>";
-    pdg2str[1114] = "&Delta;<SUP>-</SUP>";
-    pdg2str[-1114] = "&Delta;<SUP>-</SUP>";
-    //strange baryons
-    pdg2str[3122] = "&Lambda;";
-    pdg2str[-3122] = "&Lambda;";
-    pdg2str[3222] = "&Sigma;<SUP>+</SUP>";
-    pdg2str[-3222] = "&Sigma;<SUP>+</SUP>";
-    pdg2str[3212] = "&Sigma;<SUP>0</SUP>";
-    pdg2str[-3212] = "&Sigma;<SUP>0</SUP>";
-    pdg2str[3112] = "&Sigma;<SUP>-</SUP>";
-    pdg2str[-3112] = "&Sigma;<SUP>-</SUP>";
-    pdg2str[3224] = "&Sigma;<SUP>*+</SUP>";
-    pdg2str[-3224] = "&Sigma;<SUP>*+</SUP>";
-    pdg2str[3214] = "&Sigma;<SUP>*0</SUP>";
-    pdg2str[-3214] = "&Sigma;<SUP>*0</SUP>";
-    pdg2str[3114] = "&Sigma;<SUP>*-</SUP>";
-    pdg2str[-3114] = "&Sigma;<SUP>*-</SUP>";
-    pdg2str[3322] = "&Xi;<SUP>0</SUP>";
-    pdg2str[-3322] = "&Xi;<SUP>0</SUP>";
-    pdg2str[3312] = "&Xi;<SUP>-</SUP>";
-    pdg2str[-3312] = "&Xi;<SUP>-</SUP>";
-    pdg2str[3324] = "&Xi;<SUP>*0</SUP>";
-    pdg2str[-3324] = "&Xi;<SUP>*0</SUP>";
-    pdg2str[3314] = "&Xi;<SUP>*-</SUP>";
-    pdg2str[-3314] = "&Xi;<SUP>*-</SUP>";
-    pdg2str[3334] = "&Omega;<SUP>-</SUP>";
-    pdg2str[-3334] = "&Omega;<SUP>-</SUP>";
-    //charmed baryons
-    pdg2str[4122] = "&Lambda;<SUB>c</SUB><SUP>+</SUP>";
-    pdg2str[-4122] = "&Lambda;<SUB>c</SUB><SUP>-</SUP>";
-    pdg2str[4222] = "&Sigma;<SUB>c</SUB><SUP>++</SUP>";
-    pdg2str[-4222] = "&Sigma;<SUB>c</SUB><SUP>--</SUP>";
-    pdg2str[4212] = "&Sigma;<SUB>c</SUB><SUP>+</SUP>";
-    pdg2str[-4212] = "&Sigma;<SUB>c</SUB><SUP>-</SUP>";
-    pdg2str[4112] = "&Sigma;<SUB>c</SUB><SUP>0</SUP>";
-    pdg2str[-4112] = "&Sigma;<SUB>c</SUB><SUP>0</SUP>";
-    pdg2str[4224] = "&Sigma;<SUB>c</SUB><SUP>*++</SUP>";
-    pdg2str[-4224] = "&Sigma;<SUB>c</SUB><SUP>*--</SUP>";
-    pdg2str[4214] = "&Sigma;<SUB>c</SUB><SUP>*+</SUP>";
-    pdg2str[-4214] = "&Sigma;<SUB>c</SUB><SUP>*-</SUP>";
-    pdg2str[4114] = "&Sigma;<SUB>c</SUB><SUP>*0</SUP>";
-    pdg2str[-4114] = "&Sigma;<SUB>c</SUB><SUP>*0</SUP>";
-    pdg2str[4232] = "&Xi;<SUB>c</SUB><SUP>+</SUP>";
-    pdg2str[-4232] = "&Xi;<SUB>c</SUB><SUP>-</SUP>";
-    pdg2str[4132] = "&Xi;<SUB>c</SUB><SUP>0</SUP>";
-    pdg2str[-4132] = "&Xi;<SUB>c</SUB><SUP>0</SUP>";
-    pdg2str[4322] = "&Xi;<SUB>c</SUB><SUP>\'+</SUP>";
-    pdg2str[-4322] = "&Xi;<SUB>c</SUB><SUP>\'-</SUP>";
-    pdg2str[4312] = "&Xi;<SUB>c</SUB><SUP>\'0</SUP>";
-    pdg2str[-4312] = "&Xi;<SUB>c</SUB><SUP>\'0</SUP>";
-    pdg2str[4324] = "&Xi;<SUB>c</SUB><SUP>*+</SUP>";
-    pdg2str[-4324] = "&Xi;<SUB>c</SUB><SUP>*-</SUP>";
-    pdg2str[4314] = "&Xi;<SUB>c</SUB><SUP>*0</SUP>";
-    pdg2str[-4314] = "&Xi;<SUB>c</SUB><SUP>*0</SUP>";
-    pdg2str[4332] = "&Omega;<SUB>c</SUB><SUP>0</SUP>";
-    pdg2str[-4332] = "&Omega;<SUB>c</SUB><SUP>0</SUP>";
-    pdg2str[4334] = "&Omega;<SUB>c</SUB><SUP>*0</SUP>";
-    pdg2str[-4334] = "&Omega;<SUB>c</SUB><SUP>*0</SUP>";
-    pdg2str[4412] = "&Xi;<SUB>cc</SUB><SUP>+</SUP>";
-    pdg2str[-4412] = "&Xi;<SUB>cc</SUB><SUP>-</SUP>";
-    pdg2str[4422] = "&Xi;<SUB>cc</SUB><SUP>++</SUP>";
-    pdg2str[-4422] = "&Xi;<SUB>cc</SUB><SUP>--</SUP>";
-    pdg2str[4414] = "&Xi;<SUB>cc</SUB><SUP>*+</SUP>";
-    pdg2str[-4414] = "&Xi;<SUB>cc</SUB><SUP>*-</SUP>";
-    pdg2str[4424] = "&Xi;<SUB>cc</SUB><SUP>*++</SUP>";
-    pdg2str[-4424] = "&Xi;<SUB>cc</SUB><SUP>*--</SUP>";
-    pdg2str[4432] = "&Omega;<SUB>cc</SUB><SUP>+</SUP>";
-    pdg2str[-4432] = "&Omega;<SUB>cc</SUB><SUP>-</SUP>";
-    pdg2str[4434] = "&Omega;<SUB>cc</SUB><SUP>*+</SUP>";
-    pdg2str[-4434] = "&Omega;<SUB>cc</SUB><SUP>*-</SUP>";
-    pdg2str[4444] = "&Omega;<SUB>ccc</SUB><SUP>++</SUP>";
-    pdg2str[-4444] = "&Omega;<SUB>ccc</SUB><SUP>--</SUP>";
-    //bottom baryons
-    pdg2str[5122] = "&Lambda;<SUB>b</SUB><SUP>0</SUP>";
-    pdg2str[-5122] = "&Lambda;<SUB>b</SUB><SUP>0</SUP>";
-    pdg2str[5112] = "&Sigma;<SUB>b</SUB><SUP>-</SUP>";
-    pdg2str[-5112] = "&Sigma;<SUB>b</SUB><SUP>-</SUP>";
-    pdg2str[5212] = "&Sigma;<SUB>b</SUB><SUP>0</SUP>";
-    pdg2str[-5212] = "&Sigma;<SUB>b</SUB><SUP>0</SUP>";
-    pdg2str[5222] = "&Sigma;<SUB>b</SUB><SUP>+</SUP>";
-    pdg2str[-5222] = "&Sigma;<SUB>b</SUB><SUP>+</SUP>";
-    pdg2str[5114] = "&Sigma;<SUB>b</SUB><SUP>*-</SUP>";
-    pdg2str[-5114] = "&Sigma;<SUB>b</SUB><SUP>*-</SUP>";
-    pdg2str[5214] = "&Sigma;<SUB>b</SUB><SUP>*0</SUP>";
-    pdg2str[-5214] = "&Sigma;<SUB>b</SUB><SUP>*0</SUP>";
-    pdg2str[5224] = "&Sigma;<SUB>b</SUB><SUP>*+</SUP>";
-    pdg2str[-5224] = "&Sigma;<SUB>b</SUB><SUP>*+</SUP>";
-    pdg2str[5132] = "&Xi;<SUB>b</SUB><SUP>-</SUP>";
-    pdg2str[-5132] = "&Xi;<SUB>b</SUB><SUP>-</SUP>";
-    pdg2str[5232] = "&Xi;<SUB>b</SUB><SUP>0</SUP>";
-    pdg2str[-5232] = "&Xi;<SUB>b</SUB><SUP>0</SUP>";
-    pdg2str[5312] = "&Xi;<SUB>b</SUB><SUP>\'-</SUP>";
-    pdg2str[-5312] = "&Xi;<SUB>b</SUB><SUP>\'-</SUP>";
-    pdg2str[5322] = "&Xi;<SUB>b</SUB><SUP>\'0</SUP>";
-    pdg2str[-5322] = "&Xi;<SUB>b</SUB><SUP>\'0</SUP>";
-    pdg2str[5314] = "&Xi;<SUB>b</SUB><SUP>*-</SUP>";
-    pdg2str[-5314] = "&Xi;<SUB>b</SUB><SUP>*-</SUP>";
-    pdg2str[5324] = "&Xi;<SUB>b</SUB><SUP>*0</SUP>";
-    pdg2str[-5324] = "&Xi;<SUB>b</SUB><SUP>*0</SUP>";
-    pdg2str[5332] = "&Omega;<SUB>b</SUB><SUP>-</SUP>";
-    pdg2str[-5332] = "&Omega;<SUB>b</SUB><SUP>-</SUP>";
-    pdg2str[5334] = "&Omega;<SUB>b</SUB><SUP>*-</SUP>";
-    pdg2str[-5334] = "&Omega;<SUB>b</SUB><SUP>*-</SUP>";
-    pdg2str[5142] = "&Xi;<SUB>bc</SUB><SUP>0</SUP>";
-    pdg2str[-5142] = "&Xi;<SUB>bc</SUB><SUP>0</SUP>";
-    pdg2str[5242] = "&Xi;<SUB>bc</SUB><SUP>+</SUP>";
-    pdg2str[-5242] = "&Xi;<SUB>bc</SUB><SUP>-</SUP>";
-    pdg2str[5412] = "&Xi;<SUB>bc</SUB><SUP>\'0</SUP>";
-    pdg2str[-5412] = "&Xi;<SUB>bc</SUB><SUP>\'0</SUP>";
-    pdg2str[5422] = "&Xi;<SUB>bc</SUB><SUP>\'+</SUP>";
-    pdg2str[-5422] = "&Xi;<SUB>bc</SUB><SUP>\'-</SUP>";
-    pdg2str[5414] = "&Xi;<SUB>bc</SUB><SUP>*0</SUP>";
-    pdg2str[-5414] = "&Xi;<SUB>bc</SUB><SUP>*0</SUP>";
-    pdg2str[5424] = "&Xi;<SUB>bc</SUB><SUP>*+</SUP>";
-    pdg2str[-5424] = "&Xi;<SUB>bc</SUB><SUP>*-</SUP>";
-    pdg2str[5342] = "&Omega;<SUB>bc</SUB><SUP>0</SUP>";
-    pdg2str[-5342] = "&Omega;<SUB>bc</SUB><SUP>0</SUP>";
-    pdg2str[5432] = "&Omega;<SUB>bc</SUB><SUP>\'0</SUP>";
-    pdg2str[-5432] = "&Omega;<SUB>bc</SUB><SUP>\'0</SUP>";
-    pdg2str[5434] = "&Omega;<SUB>bc</SUB><SUP>*0</SUP>";
-    pdg2str[-5434] = "&Omega;<SUB>bc</SUB><SUP>*0</SUP>";
-    pdg2str[5442] = "&Omega;<SUB>bcc</SUB><SUP>+</SUP>";
-    pdg2str[-5442] = "&Omega;<SUB>bcc</SUB><SUP>-</SUP>";
-    pdg2str[5444] = "&Omega;<SUB>bcc</SUB><SUP>*+</SUP>";
-    pdg2str[-5444] = "&Omega;<SUB>bcc</SUB><SUP>*-</SUP>";
-    pdg2str[5512] = "&Xi;<SUB>bb</SUB><SUP>-</SUP>";
-    pdg2str[-5512] = "&Xi;<SUB>bb</SUB><SUP>+</SUP>";
-    pdg2str[5522] = "&Xi;<SUB>bb</SUB><SUP>0</SUP>";
-    pdg2str[-5522] = "&Xi;<SUB>bb</SUB><SUP>0</SUP>";
-    pdg2str[5514] = "&Xi;<SUB>bb</SUB><SUP>*-</SUP>";
-    pdg2str[-5514] = "&Xi;<SUB>bb</SUB><SUP>*+</SUP>";
-    pdg2str[5524] = "&Xi;<SUB>bb</SUB><SUP>*0</SUP>";
-    pdg2str[-5524] = "&Xi;<SUB>bb</SUB><SUP>*0</SUP>";
-    pdg2str[5532] = "&Omega;<SUB>bb</SUB><SUP>-</SUP>";
-    pdg2str[-5532] = "&Omega;<SUB>bb</SUB><SUP>+</SUP>";
-    pdg2str[5534] = "&Omega;<SUB>bb</SUB><SUP>*-</SUP>";
-    pdg2str[-5534] = "&Omega;<SUB>bb</SUB><SUP>*+</SUP>";
-    pdg2str[5542] = "&Omega;<SUB>bbc</SUB><SUP>0</SUP>";
-    pdg2str[-5542] = "&Omega;<SUB>bbc</SUB><SUP>0</SUP>";
-    pdg2str[5544] = "&Omega;<SUB>bbc</SUB><SUP>*0</SUP>";
-    pdg2str[-5544] = "&Omega;<SUB>bbc</SUB><SUP>*0</SUP>";
-    pdg2str[5554] = "&Omega;<SUB>bbb</SUB><SUP>-</SUP>";
-    pdg2str[-5554] = "&Omega;<SUB>bbb</SUB><SUP>+</SUP>";
-
-    return pdg2str;
+
+void DecayChainDrawer::countTopology(VertexCollection& collection, int vertex, LCEvent* event){
+    TopologyTable& topologies = collection.topologies;
+    const McGraph& graph = _adapter.graph();
+    TopologyTable::Entry& entry = topologies.find( _core.getTopologyHash(graph, _analysis, vertex) );
+    // the readable label is only built for a new topology
+    if (entry.label < 0){
+        topologies.setLabel(entry, _core.getTopologyLabel(graph, _analysis, vertex) );
+        entry.nBChains = _core.countBChains(graph, _analysis, vertex);
+    }
+    topologies.add(entry, event->getRunNumber(), event->getEventNumber());
 }
@@ -0,0 +1,198 @@
+#include "lcio.h"
+#include "EVENT/LCIO.h"
+#include "IMPL/LCCollectionVec.h"
+#include "IMPL/LCEventImpl.h"
+#include "IMPL/LCFlagImpl.h"
+#include "IMPL/LCRelationImpl.h"
+#include "IMPL/LCRunHeaderImpl.h"
+#include "IMPL/MCParticleImpl.h"
+#include "IMPL/ReconstructedParticleImpl.h"
+#include "IMPL/TrackImpl.h"
+#include "IMPL/VertexImpl.h"
+#include "IO/LCWriter.h"
+#include "IOIMPL/LCFactory.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    // fixture events: positions in mm, momenta in GeV, all exact in float
+    struct FixtureParticle {
+        int pdg;
+        int generatorStatus;
+        int parents[2];
+        double vertex[3];
+        double momentum[3];
+    };
+
+    struct FixtureEvent {
+        int event;
+        std::vector<FixtureParticle> particles;
+        //MC index of every vertex track, -1 for a track without MC link
+        std::vector< std::vector<int> > vertices;
+    };
+
+    const std::vector<FixtureEvent> fixtureEvents = {
+        // b bbar: B+ and B- cascades, one vertex merging the B+ and D0bar decays, one fake track
+        {1, {
+            {11, 4, {-1, -1}, {0., 0., 0.}, {0., 0., 125.}},
+            {-11, 4, {-1, -1}, {0., 0., 0.}, {0., 0., -125.}},
+            {5, 2, {0, 1}, {0., 0., 0.}, {10.5, 4.25, 60.}},
+            {-5, 2, {0, 1}, {0., 0., 0.}, {-10.5, -4.25, -60.}},
+            {92, 2, {2, 3}, {0., 0., 0.}, {0., 0., 0.}},
+            {521, 2, {4, -1}, {0., 0., 0.}, {8.25, 3.5, 45.5}},
+            {-521, 2, {4, -1}, {0., 0., 0.}, {-7.5, 5.25, -38.75}},
+            {211, 1, {4, -1}, {0., 0., 0.}, {1.25, 0.5, 6.}},
+            {-211, 1, {4, -1}, {0., 0., 0.}, {-0.75, -1.5, -4.25}},
+            {-421, 2, {5, -1}, {0.5, 0.25, 1.}, {5.5, 2.25, 30.5}},
+            {211, 1, {5, -1}, {0.5, 0.25, 1.}, {2.75, 1.25, 15.}},
+            {321, 1, {9, -1}, {1.5, 0.75, 2.5}, {3.25, 1.5, 18.25}},
+            {-211, 1, {9, -1}, {1.5, 0.75, 2.5}, {2.25, 0.75, 12.25}},
+            {421, 2, {6, -1}, {-0.75, 0.5, -1.25}, {-4.5, 3.25, -25.5}},
+            {-211, 1, {6, -1}, {-0.75, 0.5, -1.25}, {-3., 2., -13.25}},
+            {-321, 1, {13, -1}, {-2., 1.25, -3.}, {-2.5, 2., -14.75}},
+            {211, 1, {13, -1}, {-2., 1.25, -3.}, {-2., 1.25, -10.75}},
+        }, {
+            {10, 11, 12},
+            {14, 15, 16, -1},
+        }},
+        // c cbar: D+ and D- decays, a long-lived K0S and a vertex mixing both D chains
+        {2, {
+            {11, 4, {-1, -1}, {0., 0., 0.}, {0., 0., 125.}},
+            {-11, 4, {-1, -1}, {0., 0., 0.}, {0., 0., -125.}},
+            {4, 2, {0, 1}, {0., 0., 0.}, {-20.25, 12.5, 30.}},
+            {-4, 2, {0, 1}, {0., 0., 0.}, {20.25, -12.5, -30.}},
+            {92, 2, {2, 3}, {0., 0., 0.}, {0., 0., 0.}},
+            {411, 2, {4, -1}, {0., 0., 0.}, {-15.5, 9.25, 22.5}},
+            {-411, 2, {4, -1}, {0., 0., 0.}, {14.75, -8.5, -21.25}},
+            {310, 2, {4, -1}, {0., 0., 0.}, {3.5, 2.5, 6.75}},
+            {-321, 1, {5, -1}, {-0.25, 0.125, 0.375}, {-7.25, 4.5, 10.5}},
+            {211, 1, {5, -1}, {-0.25, 0.125, 0.375}, {-4.5, 2.25, 6.5}},
+            {211, 1, {5, -1}, {-0.25, 0.125, 0.375}, {-3.75, 2.5, 5.5}},
+            {321, 1, {6, -1}, {0.375, -0.25, -0.5}, {7., -4.25, -10.}},
+            {-211, 1, {6, -1}, {0.375, -0.25, -0.5}, {4.25, -2., -6.25}},
+            {-211, 1, {6, -1}, {0.375, -0.25, -0.5}, {3.5, -2.25, -5.}},
+            {211, 1, {7, -1}, {20., 14.25, 38.5}, {2., 1.5, 3.75}},
+            {-211, 1, {7, -1}, {20., 14.25, 38.5}, {1.5, 1., 3.}},
+        }, {
+            {8, 9, 10},
+            {14, 15},
+            {11, 9},
+        }},
+        // light quarks only: no vertex, no graph
+        {3, {
+            {11, 4, {-1, -1}, {0., 0., 0.}, {0., 0., 125.}},
+            {-11, 4, {-1, -1}, {0., 0., 0.}, {0., 0., -125.}},
+            {1, 2, {0, 1}, {0., 0., 0.}, {30.5, -2.25, 12.}},
+            {-1, 2, {0, 1}, {0., 0., 0.}, {-30.5, 2.25, -12.}},
+            {92, 2, {2, 3}, {0., 0., 0.}, {0., 0., 0.}},
+            {211, 1, {4, -1}, {0., 0., 0.}, {15.25, -1., 6.5}},
+            {-211, 1, {4, -1}, {0., 0., 0.}, {-15.25, 1., -6.5}},
+        }, {}},
+    };
+
+    // LCIO track weight 1, cluster weight 0
+    constexpr float fullTrackWeight = 1000.;
+
+    IMPL::LCEventImpl* makeEvent(int run, const FixtureEvent& fixture){
+        using namespace IMPL;
+        LCEventImpl* event = new LCEventImpl;
+        event->setRunNumber(run);
+        event->setEventNumber(fixture.event);
+        event->setDetectorName("DecayChainFixture");
+
+        LCCollectionVec* mcCol = new LCCollectionVec(EVENT::LCIO::MCPARTICLE);
+        std::vector<MCParticleImpl*> particles;
+        for(auto& fixtureParticle : fixture.particles){
+            MCParticleImpl* mc = new MCParticleImpl;
+            mc->setPDG(fixtureParticle.pdg);
+            mc->setGeneratorStatus(fixtureParticle.generatorStatus);
+            mc->setVertex(fixtureParticle.vertex);
+            mc->setMomentum(fixtureParticle.momentum);
+            for(auto parent : fixtureParticle.parents){
+                if (parent >= 0) mc->addParent(particles[parent]);
+            }
+            particles.push_back(mc);
+            mcCol->addElement(mc);
+        }
+        // a particle ends where its first daughter starts
+        for(auto mc : particles){
+            if ( !mc->getDaughters().empty() ) mc->setEndpoint( mc->getDaughters()[0]->getVertex() );
+        }
+
+        LCCollectionVec* tracks = new LCCollectionVec(EVENT::LCIO::TRACK);
+        LCCollectionVec* pfos = new LCCollectionVec(EVENT::LCIO::RECONSTRUCTEDPARTICLE);
+        LCCollectionVec* vertexParticles = new LCCollectionVec(EVENT::LCIO::RECONSTRUCTEDPARTICLE);
+        LCCollectionVec* vertices = new LCCollectionVec(EVENT::LCIO::VERTEX);
+        LCCollectionVec* links = new LCCollectionVec(EVENT::LCIO::LCRELATION);
+        LCFlagImpl linkFlag;
+        linkFlag.setBit(EVENT::LCIO::LCREL_WEIGHTED);
+        links->setFlag( linkFlag.getFlag() );
+        links->parameters().setValue("FromType", EVENT::LCIO::RECONSTRUCTEDPARTICLE);
+        links->parameters().setValue("ToType", EVENT::LCIO::MCPARTICLE);
+
+        for(auto& vertexTracks : fixture.vertices){
+            ReconstructedParticleImpl* vertexParticle = new ReconstructedParticleImpl;
+            for(auto mcIndex : vertexTracks){
+                TrackImpl* track = new TrackImpl;
+                tracks->addElement(track);
+                ReconstructedParticleImpl* pfo = new ReconstructedParticleImpl;
+                pfo->addTrack(track);
+                // fake tracks get a momentum but no MC link
+                const double fakeMomentum[3] = {0.5, 0.5, 0.5};
+                pfo->setMomentum(mcIndex >= 0 ? particles[mcIndex]->getMomentum() : fakeMomentum);
+                pfos->addElement(pfo);
+                vertexParticle->addParticle(pfo);
+                if (mcIndex >= 0) links->addElement( new LCRelationImpl(pfo, particles[mcIndex], fullTrackWeight) );
+            }
+            vertexParticles->addElement(vertexParticle);
+
+            VertexImpl* vertex = new VertexImpl;
+            const double* position = particles[ vertexTracks[0] < 0 ? 0 : vertexTracks[0] ]->getVertex();
+            vertex->setPosition(position[0], position[1], position[2]);
+            vertex->setAlgorithmType("DecayChainFixture");
+            vertex->setAssociatedParticle(vertexParticle);
+            vertices->addElement(vertex);
+            vertexParticle->setStartVertex(vertex);
+        }
+
+        event->addCollection(mcCol, "MCParticle");
+        event->addCollection(tracks, "MarlinTrkTracks");
+        event->addCollection(pfos, "PandoraPFOs");
+        event->addCollection(vertexParticles, "BuildUpVertex_RP");
+        event->addCollection(vertices, "BuildUpVertex");
+        event->addCollection(links, "RecoMCTruthLink");
+        return event;
+    }
+}
+
+
+/**
+ * Writes the small fixture of the regression gate: a few hand-made events in the format of
+ * ILD reconstruction (MCParticle, PandoraPFOs, BuildUpVertex, RecoMCTruthLink), so the
+ * golden run needs neither grid access nor a simulation.
+ * Usage: DecayChainFixture events.slcio
+ */
+int main(int argc, char** argv){
+    if (argc != 2){
+        std::cerr<<"Usage: "<<argv[0]<<" <output slcio>"<<std::endl;
+        return 1;
+    }
+    const int run = 1;
+    std::unique_ptr<IO::LCWriter> writer( IOIMPL::LCFactory::getInstance()->createLCWriter() );
+    writer->open(argv[1], EVENT::LCIO::WRITE_NEW);
+
+    IMPL::LCRunHeaderImpl runHeader;
+    runHeader.setRunNumber(run);
+    runHeader.setDetectorName("DecayChainFixture");
+    writer->writeRunHeader(&runHeader);
+    for(auto& fixture : fixtureEvents){
+        std::unique_ptr<IMPL::LCEventImpl> event( makeEvent(run, fixture) );
+        writer->writeEvent( event.get() );
+    }
+    writer->close();
+    std::cout<<"Wrote "<<fixtureEvents.size()<<" events to "<<argv[1]<<std::endl;
+    return 0;
+}
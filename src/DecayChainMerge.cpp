@@ -0,0 +1,38 @@
+#include "ShardIndex.hpp"
+
+#include <iostream>
+
+/**
+ * Merges the shard indices written by DecayChainDrawer jobs into a global
+ * (run, event) sorted index. Graph files are referenced, not copied or re-rendered,
+ * and every graph keeps the input file it came from.
+ * Usage: DecayChainMerge merged.index shard1.index [shard2.index ...]
+ */
+int main(int argc, char** argv){
+    if (argc < 3){
+        std::cerr<<"Usage: "<<argv[0]<<" <merged index> <shard index> [<shard index> ...]"<<std::endl;
+        return 1;
+    }
+
+    ShardIndex merged;
+    merged.name = "merged";
+    for(int i=2; i<argc; ++i){
+        ShardIndex shard;
+        if ( !shard.read(argv[i]) ){
+            std::cerr<<"Cannot read shard index "<<argv[i]<<std::endl;
+            return 1;
+        }
+        merged.merge(shard);
+    }
+    merged.sort();
+
+    int nDuplicates = merged.countDuplicates();
+    if (nDuplicates > 0) std::cerr<<"Warning: "<<nDuplicates<<" (run, event, vertex collection) appear in more than one shard"<<std::endl;
+
+    if ( !merged.write(argv[1]) ){
+        std::cerr<<"Cannot write merged index "<<argv[1]<<std::endl;
+        return 1;
+    }
+    std::cout<<"Merged "<<argc-2<<" shards: "<<merged.inputs.size()<<" input files, "<<merged.entries.size()<<" events"<<std::endl;
+    return 0;
+}
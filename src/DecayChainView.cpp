@@ -0,0 +1,201 @@
+#include "DecayChainCore.hpp"
+#include "EventArena.hpp"
+#include "GraphRenderer.hpp"
+#include "LcioAdapter.hpp"
+
+#include "lcio.h"
+#include "IOIMPL/LCFactory.h"
+#include "IO/LCReader.h"
+#include "UTIL/LCRelationNavigator.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Options {
+        std::string inputFile{};
+        std::vector<std::string> vertexCollections{};
+        std::string outputDirectory{"."};
+        bool openViewer{true};
+        double renderTimeout{10.};
+        int layoutThreads{1};
+    };
+
+    /**
+     * Analyses and renders single events of one file. The reader and the per-event
+     * buffers are kept open between lookups, so only the first one pays for the
+     * direct-access index of the file.
+     */
+    class EventViewer {
+        public:
+            explicit EventViewer(const Options& options) : _options(options){
+                _reader.reset( IOIMPL::LCFactory::getInstance()->createLCReader(IO::LCReader::directAccess) );
+                _reader->open(_options.inputFile);
+                _arena.reserve(1 << 20);
+                _pdgNames = DecayChainCore::getPdgNamesMap();
+                _vtxPalettes = DecayChainCore::getVertexPalettes();
+                _name = std::filesystem::path(_options.inputFile).stem().string();
+                _renderer.setup(_options.renderTimeout, _options.layoutThreads);
+            }
+            ~EventViewer(){_reader->close();}
+
+            //false if the event is not in the file
+            bool draw(int run, int eventNumber);
+
+        private:
+            //renders <graphPath>.dot, written before
+            void writeGraph(const std::string& graphPath, const std::vector<std::string>& groupGraphs);
+
+            const Options& _options;
+            std::unique_ptr<IO::LCReader> _reader{};
+            //declared before everything allocating from it
+            EventArena _arena{};
+            LcioAdapter _adapter{&_arena};
+            DecayChainCore _core{&_arena};
+            EventAnalysis _analysis{&_arena};
+            std::map<int, std::string> _pdgNames{};
+            std::vector< std::vector<std::string> > _vtxPalettes{};
+            std::string _name{};
+            GraphRenderer _renderer{};
+    };
+
+
+    bool EventViewer::draw(int run, int eventNumber){
+        auto start = std::chrono::steady_clock::now();
+        EVENT::LCEvent* event = _reader->readEvent(run, eventNumber);
+        if (event == nullptr) return false;
+        double readTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        _analysis.clear();
+        _core.clear();
+        _adapter.clear();
+        _arena.reset();
+
+        UTIL::LCRelationNavigator navRecoToMc( event->getCollection("RecoMCTruthLink") );
+        const McGraph& graph = _adapter.setMcParticles( event->getCollection("MCParticle") );
+        _core.beginEvent(graph, _analysis);
+        _core.analyseMc(graph, _analysis);
+
+        for(size_t i=0; i<_options.vertexCollections.size(); ++i){
+            const std::string& collectionName = _options.vertexCollections[i];
+            EVENT::LCCollection* vertices = event->getCollection(collectionName);
+            // as in the processor, a collection without vertices has no graph
+            if (vertices->getNumberOfElements() == 0) continue;
+            const VertexTracks& tracks = _adapter.setVertices(vertices, navRecoToMc);
+            _core.analyseVertices(graph, tracks, _analysis);
+            _core.describeGraph(graph, _analysis);
+
+            const std::vector<std::string>& vtxColors = _vtxPalettes[i % _vtxPalettes.size()];
+            std::pmr::string dotGraph(&_arena);
+            DrawnGraph drawnGraph = _analysis.drawnGraph();
+            DecayChainCore::writeDotGraph(drawnGraph, _pdgNames, vtxColors, dotGraph);
+            //same naming as the processor with the file name as shard name
+            std::string graphPath = _options.outputDirectory + "/" + _name + "_" + collectionName + "_r" + std::to_string(run) + "_e" + std::to_string(eventNumber);
+            std::ofstream outfile(graphPath + ".dot");
+            outfile<<dotGraph;
+            outfile.close();
+
+            std::vector<std::string> groupGraphs;
+            if (_renderer.isParallel() && drawnGraph.nLayoutGroups > 1){
+                for(int g=0; g<drawnGraph.nLayoutGroups; ++g){
+                    DecayChainCore::writeDotGraph(drawnGraph, _pdgNames, vtxColors, dotGraph, g);
+                    groupGraphs.emplace_back(dotGraph);
+                }
+            }
+            writeGraph(graphPath, groupGraphs);
+            _core.resetVertices(_analysis);
+        }
+        double totalTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout<<"Event "<<run<<":"<<eventNumber<<" read in "<<readTime<<" s, drawn in "<<totalTime<<" s"<<std::endl;
+        return true;
+    }
+
+
+    void EventViewer::writeGraph(const std::string& graphPath, const std::vector<std::string>& groupGraphs){
+        GraphRenderer::Result result = _renderer.render(graphPath, groupGraphs);
+        if (result == GraphRenderer::Result::reduced) std::cerr<<"Layout exceeded "<<_options.renderTimeout<<" s, rendered with reduced layout"<<std::endl;
+        else if (result == GraphRenderer::Result::plainDot) std::cerr<<"Layout exceeded "<<_options.renderTimeout<<" s twice, see "<<graphPath<<".dot"<<std::endl;
+        else if (result == GraphRenderer::Result::failed) std::cerr<<"dot failed to render "<<graphPath<<".dot"<<std::endl;
+        bool hasSvg = result == GraphRenderer::Result::rendered || result == GraphRenderer::Result::reduced;
+        if (_options.openViewer && hasSvg) system( ("xdg-open " + graphPath + ".svg").c_str() );
+    }
+
+
+    bool drawEvent(EventViewer& viewer, const std::string& line){
+        std::istringstream pair(line);
+        int run, eventNumber;
+        if ( !(pair>>run>>eventNumber) ){
+            std::cerr<<"Expected: <run> <event>"<<std::endl;
+            return false;
+        }
+        try{
+            if ( viewer.draw(run, eventNumber) ) return true;
+            std::cerr<<"Event "<<run<<":"<<eventNumber<<" is not in the file"<<std::endl;
+        }
+        catch(const lcio::Exception& e){
+            std::cerr<<"Cannot draw event "<<run<<":"<<eventNumber<<": "<<e.what()<<std::endl;
+        }
+        return false;
+    }
+}
+
+
+/**
+ * Draws single events of an LCIO file without reading through it sequentially.
+ * Events are looked up with the direct access of the LCIO reader.
+ * With run and event given the event is drawn once, otherwise "run event" pairs are read from stdin.
+ * Usage: DecayChainView [-c collection]... [-o directory] [-t seconds] [-j threads] [-n] file.slcio [run event]
+ */
+int main(int argc, char** argv){
+    Options options;
+    std::vector<std::string> positional;
+    for(int i=1; i<argc; ++i){
+        std::string arg = argv[i];
+        if (arg == "-c" && i+1 < argc) options.vertexCollections.push_back(argv[++i]);
+        else if (arg == "-o" && i+1 < argc) options.outputDirectory = argv[++i];
+        else if (arg == "-j" && i+1 < argc) options.layoutThreads = std::atoi(argv[++i]);
+        else if (arg == "-t" && i+1 < argc) options.renderTimeout = std::atof(argv[++i]);
+        else if (arg == "-n") options.openViewer = false;
+        else positional.push_back(arg);
+    }
+    if (positional.size() != 1 && positional.size() != 3){
+        std::cerr<<"Usage: "<<argv[0]<<" [-c <vertex collection>]... [-o <output directory>] [-t <seconds>] [-j <threads>] [-n] <file.slcio> [<run> <event>]"<<std::endl;
+        std::cerr<<"  -c  vertex collection to draw, repeat for several (default BuildUpVertex)"<<std::endl;
+        std::cerr<<"  -o  directory for the graph files (default .)"<<std::endl;
+        std::cerr<<"  -t  layout time budget, 0 for no limit (default 10)"<<std::endl;
+        std::cerr<<"  -j  threads for the layout of disconnected parts, 0 for all cores (default 1, one layout per graph)"<<std::endl;
+        std::cerr<<"  -n  do not open the rendered graphs"<<std::endl;
+        std::cerr<<"Without <run> <event> the pairs are read from stdin until an empty line"<<std::endl;
+        return 1;
+    }
+    options.inputFile = positional[0];
+    if ( options.vertexCollections.empty() ) options.vertexCollections.push_back("BuildUpVertex");
+    std::filesystem::create_directories(options.outputDirectory);
+
+    std::unique_ptr<EventViewer> viewer;
+    try{
+        viewer = std::make_unique<EventViewer>(options);
+    }
+    catch(const lcio::Exception& e){
+        std::cerr<<"Cannot open "<<options.inputFile<<": "<<e.what()<<std::endl;
+        return 1;
+    }
+
+    if (positional.size() == 3) return drawEvent(*viewer, positional[1] + " " + positional[2]) ? 0 : 1;
+
+    std::string line;
+    std::cout<<"run event> "<<std::flush;
+    while( std::getline(std::cin, line) && !line.empty() ){
+        drawEvent(*viewer, line);
+        std::cout<<"run event> "<<std::flush;
+    }
+    return 0;
+}
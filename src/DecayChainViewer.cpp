@@ -0,0 +1,205 @@
+#include "GraphRenderer.hpp"
+#include "GraphRing.hpp"
+
+#ifdef DECAYCHAIN_WITH_GVC
+#include <gvc.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace {
+    volatile std::sig_atomic_t stopped = 0;
+    void stop(int){stopped = 1;}
+
+#ifdef DECAYCHAIN_WITH_GVC
+    // the reduced layout of GraphRenderer as graph attributes: bounded network simplex and mincross
+    const std::pair<const char*, const char*> reducedLayout[] = {{"nslimit", "1"}, {"nslimit1", "1"}, {"mclimit", "0"}, {"searchsize", "0"}, {"splines", "line"}};
+#endif
+
+    /**
+     * Turns DOT text into SVG text under the render time budget.
+     * With libgvc the Graphviz context stays loaded for the whole session and graphs are laid out
+     * in-process straight to memory. gvLayout cannot be interrupted, so the budget is kept ahead of
+     * time: a graph whose layout time, estimated from the size of earlier full layouts, exceeds
+     * half of the budget gets the reduced layout right away.
+     * Without libgvc the viewer is degraded to what the processor does, a .dot file and a dot
+     * process per graph.
+     */
+    class SvgRenderer {
+        public:
+            SvgRenderer(const std::string& directory, double timeout) : _directory(directory), _timeout(timeout){
+#ifdef DECAYCHAIN_WITH_GVC
+                _gvc = gvContext();
+#endif
+                _renderer.setup(timeout, 1);
+            }
+            ~SvgRenderer(){
+#ifdef DECAYCHAIN_WITH_GVC
+                gvFreeContext(_gvc);
+#endif
+            }
+
+            //false if the graph could not be laid out, reduced if the reduced layout was used
+            bool render(const std::string& dotGraph, std::string& svg, bool& reduced);
+
+        private:
+            std::string _directory;
+            double _timeout;
+            GraphRenderer _renderer{};
+#ifdef DECAYCHAIN_WITH_GVC
+            GVC_t* _gvc{};
+            //layout seconds per node and edge, raised at once by a slow graph and lowered slowly
+            double _secondsPerElement{};
+#endif
+    };
+
+
+    bool SvgRenderer::render(const std::string& dotGraph, std::string& svg, bool& reduced){
+#ifdef DECAYCHAIN_WITH_GVC
+        Agraph_t* graph = agmemread( dotGraph.c_str() );
+        if (graph == nullptr) return false;
+        int size = agnnodes(graph) + agnedges(graph);
+        reduced = _timeout > 0. && _secondsPerElement * size > 0.5 * _timeout;
+        if (reduced){
+            for(auto& [name, value] : reducedLayout) agsafeset(graph, const_cast<char*>(name), const_cast<char*>(value), const_cast<char*>(""));
+        }
+        auto start = std::chrono::steady_clock::now();
+        bool done = gvLayout(_gvc, graph, "dot") == 0;
+        if (done){
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if ( !reduced && size > 0 ) _secondsPerElement = std::max(seconds / size, 0.9 * _secondsPerElement);
+            char* data;
+            unsigned int length;
+            done = gvRenderData(_gvc, graph, "svg", &data, &length) == 0;
+            if (done) svg.assign(data, length);
+            if (done) gvFreeRenderData(data);
+            gvFreeLayout(_gvc, graph);
+        }
+        agclose(graph);
+        return done;
+#else
+        std::string graphPath = _directory + "/DecayChainViewer.current";
+        std::ofstream outfile(graphPath + ".dot");
+        outfile<<dotGraph;
+        outfile.close();
+        GraphRenderer::Result result = _renderer.render(graphPath);
+        if (result != GraphRenderer::Result::rendered && result != GraphRenderer::Result::reduced) return false;
+        reduced = result == GraphRenderer::Result::reduced;
+        std::ifstream infile(graphPath + ".svg");
+        svg.assign( (std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>() );
+        return true;
+#endif
+    }
+
+
+    //replaced in one rename, so the browser never reloads a half written page
+    void writePage(const std::string& pagePath, const std::string& title, const std::string& svg, double refresh){
+        std::ofstream page(pagePath + ".tmp");
+        page<<"<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><meta http-equiv=\"refresh\" content=\""<<refresh<<"\">";
+        page<<"<title>"<<title<<"</title></head>\n<body><h3>"<<title<<"</h3>\n"<<svg<<"\n</body></html>\n";
+        page.close();
+        std::rename( (pagePath + ".tmp").c_str(), pagePath.c_str() );
+    }
+}
+
+
+/**
+ * Long-lived viewer of DecayChainDrawer jobs on the same machine.
+ * Creates the shared-memory ring named by the processor parameter ViewerRing, renders
+ * the latest graph published into it and shows it in a self-refreshing page, opened once.
+ * Graphs that are already superseded in the ring are skipped, with -k every graph is
+ * laid out and kept as <name>.svg.
+ * Usage: DecayChainViewer [-r ring] [-s slots] [-b slot bytes] [-o directory] [-t seconds] [-k] [-n]
+ */
+int main(int argc, char** argv){
+    std::string ringName = "DecayChainDrawer";
+    int nSlots = 16;
+    size_t slotSize = 4 << 20;
+    std::string directory = ".";
+    double timeout = 10.;
+    bool keepGraphs = false;
+    bool openViewer = true;
+    for(int i=1; i<argc; ++i){
+        std::string arg = argv[i];
+        if (arg == "-r" && i+1 < argc) ringName = argv[++i];
+        else if (arg == "-s" && i+1 < argc) nSlots = std::atoi(argv[++i]);
+        else if (arg == "-b" && i+1 < argc) slotSize = std::atol(argv[++i]);
+        else if (arg == "-o" && i+1 < argc) directory = argv[++i];
+        else if (arg == "-t" && i+1 < argc) timeout = std::atof(argv[++i]);
+        else if (arg == "-k") keepGraphs = true;
+        else if (arg == "-n") openViewer = false;
+        else{
+            std::cerr<<"Usage: "<<argv[0]<<" [-r <ring>] [-s <slots>] [-b <slot bytes>] [-o <directory>] [-t <seconds>] [-k] [-n]"<<std::endl;
+            std::cerr<<"  -r  shared-memory ring, the ViewerRing of the processor (default DecayChainDrawer)"<<std::endl;
+            std::cerr<<"  -s  graphs queued before the processor falls back to files (default 16)"<<std::endl;
+            std::cerr<<"  -b  largest graph name and text in bytes (default 4194304)"<<std::endl;
+            std::cerr<<"  -o  directory of the page and kept graphs (default .)"<<std::endl;
+            std::cerr<<"  -t  layout time budget per graph in seconds, 0 for no limit (default 10)"<<std::endl;
+            std::cerr<<"  -k  keep every graph as <name>.svg"<<std::endl;
+            std::cerr<<"  -n  do not open the page"<<std::endl;
+            return 1;
+        }
+    }
+    std::filesystem::create_directories(directory);
+
+    GraphRing ring;
+    if ( nSlots <= 0 || !ring.create(ringName, nSlots, slotSize) ){
+        std::cerr<<"Cannot create shared memory ring /"<<ringName<<std::endl;
+        return 1;
+    }
+    // the ring is unlinked on the way out
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+
+    SvgRenderer renderer(directory, timeout);
+    std::string pagePath = directory + "/DecayChainViewer.html";
+    writePage(pagePath, "Waiting for DecayChainDrawer on ring " + ringName, "", 1.);
+    if (openViewer) std::system( ("xdg-open " + pagePath + " &").c_str() );
+    std::cout<<"Listening on /"<<ringName<<", showing "<<pagePath<<std::endl;
+
+    std::string graphName, dotGraph, svg, shownTitle;
+    int run, event;
+    long nSkipped = 0;
+    while ( !stopped ){
+        if ( !ring.consume(graphName, run, event, dotGraph) ){
+            std::this_thread::sleep_for( std::chrono::milliseconds(20) );
+            continue;
+        }
+        // a graph with newer ones queued behind it would never be seen, only kept graphs are all laid out
+        bool isLatest = ring.empty();
+        if ( !isLatest && !keepGraphs ){
+            ++nSkipped;
+            continue;
+        }
+        auto start = std::chrono::steady_clock::now();
+        std::string title = graphName + " (run " + std::to_string(run) + ", event " + std::to_string(event) + ")";
+        bool reduced;
+        if ( !renderer.render(dotGraph, svg, reduced) ){
+            std::cerr<<"Cannot lay out "<<graphName<<std::endl;
+            continue;
+        }
+        if (keepGraphs) std::ofstream(directory + "/" + graphName + ".svg")<<svg;
+        // the page is only rewritten when the displayed graph changes
+        if (isLatest && title != shownTitle){
+            writePage(pagePath, title, svg, 1.);
+            shownTitle = title;
+        }
+        std::cout<<title<<(isLatest ? " shown" : " kept")<<" after "<<std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()<<" s";
+        if (reduced) std::cout<<" with reduced layout";
+        if (nSkipped > 0) std::cout<<", "<<nSkipped<<" older graphs skipped";
+        std::cout<<std::endl;
+        nSkipped = 0;
+    }
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include "DetectorRegions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+void DetectorRegions::add(const std::string& name, double rMin, double zHalf){
+    _regions.push_back({name, rMin, zHalf});
+}
+
+
+void DetectorRegions::finish(){
+    std::stable_sort(_regions.begin(), _regions.end(), [](const Region& a, const Region& b){return a.rMin < b.rMin;});
+    if ( _regions.empty() ) return;
+    // the beam pipe is the only region whose inner radius is 0, it runs along the whole beam line
+    if (_regions.front().rMin > 0.) _regions.insert(_regions.begin(), {"beam pipe", 0., std::numeric_limits<double>::infinity()});
+
+    size_t tableSize = 1;
+    while (tableSize < _regions.size()) tableSize *= 2;
+    _names.clear();
+    _r2Min.assign(tableSize, std::numeric_limits<double>::infinity());
+    _zHalf.assign(tableSize, 0.);
+    for(size_t i=0; i<_regions.size(); ++i){
+        _names.push_back(_regions[i].name);
+        _r2Min[i] = _regions[i].rMin * _regions[i].rMin;
+        _zHalf[i] = _regions[i].zHalf;
+    }
+    _forward = _names.size();
+    _names.push_back("forward");
+}
+
+
+void DetectorRegions::classify(const double* x, const double* y, const double* z, int n, int* region) const{
+    int tableSize = _r2Min.size();
+    const double* r2Min = _r2Min.data();
+    const double* zHalf = _zHalf.data();
+    for(int k=0; k<n; ++k){
+        double r2 = x[k]*x[k] + y[k]*y[k];
+        // fixed number of steps, the comparisons become conditional moves
+        int i = 0;
+        for(int step = tableSize/2; step > 0; step /= 2) i += (r2Min[i + step] <= r2) ? step : 0;
+        region[k] = std::abs(z[k]) > zHalf[i] ? _forward : i;
+    }
+}
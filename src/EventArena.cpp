@@ -0,0 +1,27 @@
+#include "EventArena.hpp"
+
+EventArena::EventArena(std::size_t size){
+    reserve(size);
+}
+
+void EventArena::reserve(std::size_t size){
+    // all memory handed out so far is invalidated together with the old buffer
+    _resource.reset();
+    _buffer.resize(size);
+    _buffer.shrink_to_fit();
+    _resource = std::make_unique<std::pmr::monotonic_buffer_resource>(_buffer.data(), _buffer.size(), std::pmr::new_delete_resource());
+    _used = 0;
+}
+
+void EventArena::reset(){
+    // last event spilled to the heap: grow with some headroom for alignment padding
+    if (_used > _buffer.size()) reserve(_used + _used/2);
+    else _resource->release();
+    _used = 0;
+}
+
+void* EventArena::do_allocate(std::size_t bytes, std::size_t alignment){
+    _used += bytes;
+    if (_used > _peak) _peak = _used;
+    return _resource->allocate(bytes, alignment);
+}
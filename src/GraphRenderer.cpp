@@ -0,0 +1,181 @@
+#include "GraphRenderer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <ostream>
+#include <thread>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char** environ;
+
+using namespace std;
+
+namespace {
+    // network simplex and mincross dominate pathological layouts
+    const std::vector<std::string> reducedLayout = {"-Gnslimit=1", "-Gnslimit1=1", "-Gmclimit=0", "-Gsearchsize=0", "-Gsplines=line"};
+
+    using Clock = std::chrono::steady_clock;
+    constexpr Clock::time_point noDeadline = Clock::time_point::max();
+
+    //point after the given share of the time left before the deadline
+    Clock::time_point within(Clock::time_point deadline, double share){
+        if (deadline == noDeadline) return deadline;
+        auto now = Clock::now();
+        return now + std::chrono::duration_cast<Clock::duration>( (deadline - now) * share );
+    }
+}
+
+
+void GraphRenderer::setup(double timeout, int nThreads){
+    _timeout = timeout;
+    _nThreads = nThreads > 0 ? nThreads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+
+GraphRenderer::Result GraphRenderer::render(const std::string& graphPath, const std::vector<std::string>& groupGraphs){
+    auto start = Clock::now();
+    // one budget for everything done for this graph
+    Deadline deadline = _timeout > 0. ? start + std::chrono::duration_cast<Clock::duration>( std::chrono::duration<double>(_timeout) ) : noDeadline;
+    Result result = Result::failed;
+    if (isParallel() && groupGraphs.size() > 1){
+        result = renderGroups(graphPath, groupGraphs, deadline);
+        if (result != Result::failed) ++_nParallel;
+    }
+    // also when gvpack is missing or a group could not be drawn, in the time that is left
+    if (result == Result::failed) result = renderWhole(graphPath, deadline);
+    // a killed layout leaves a truncated svg
+    if (result == Result::plainDot || result == Result::failed) std::remove( (graphPath + ".svg").c_str() );
+
+    if (result == Result::rendered) ++_nRendered;
+    else if (result == Result::reduced) ++_nReduced;
+    else if (result == Result::plainDot) ++_nPlainDot;
+    else ++_nFailed;
+    _maxSeconds = std::max(_maxSeconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return result;
+}
+
+
+GraphRenderer::Result GraphRenderer::renderWhole(const std::string& graphPath, Deadline deadline){
+    bool reduced = false;
+    int status = layout("-Tsvg", graphPath + ".dot", graphPath + ".svg", deadline, reduced);
+    if (status < 0) return Result::plainDot;
+    if (status > 0) return Result::failed;
+    return reduced ? Result::reduced : Result::rendered;
+}
+
+
+int GraphRenderer::layout(const std::string& format, const std::string& dotPath, const std::string& outputPath, Deadline deadline, bool& reduced){
+    reduced = false;
+    int status = run({"dot", format, dotPath}, outputPath, within(deadline, 0.5));
+    if (status >= 0) return status;
+
+    reduced = true;
+    std::vector<std::string> args = {"dot", format};
+    args.insert(args.end(), reducedLayout.begin(), reducedLayout.end());
+    args.push_back(dotPath);
+    return run(args, outputPath, deadline);
+}
+
+
+GraphRenderer::Result GraphRenderer::renderGroups(const std::string& graphPath, const std::vector<std::string>& groupGraphs, Deadline deadline){
+    int nGroups = groupGraphs.size();
+    std::vector<std::string> groupPaths(nGroups);
+    for(int i=0; i<nGroups; ++i){
+        groupPaths[i] = graphPath + "_g" + std::to_string(i);
+        std::ofstream outfile(groupPaths[i] + ".dot");
+        outfile<<groupGraphs[i];
+    }
+
+    // groups come largest first, so the wall time is set by the largest one
+    Deadline layoutDeadline = within(deadline, 0.75);
+    std::vector<int> status(nGroups);
+    std::vector<char> reduced(nGroups);
+    std::atomic<int> next{0};
+    auto layoutGroups = [&](){
+        for(int i=next++; i<nGroups; i=next++){
+            bool groupReduced;
+            status[i] = layout("-Tdot", groupPaths[i] + ".dot", groupPaths[i] + ".laid.dot", layoutDeadline, groupReduced);
+            reduced[i] = groupReduced;
+        }
+    };
+    // threads only wait on dot children, starting them per graph costs little next to a spawn
+    std::vector<std::thread> workers;
+    for(int i=1; i<std::min(_nThreads, nGroups); ++i) workers.emplace_back(layoutGroups);
+    layoutGroups();
+    for(auto& worker : workers) worker.join();
+
+    Result result = Result::rendered;
+    for(int i=0; i<nGroups; ++i){
+        if (status[i] < 0) result = Result::plainDot;
+        else if (status[i] > 0 && result != Result::plainDot) result = Result::failed;
+        else if (reduced[i] && result == Result::rendered) result = Result::reduced;
+    }
+
+    if (result == Result::rendered || result == Result::reduced){
+        // components keep their layout, only their positions on the canvas are chosen
+        std::vector<std::string> pack = {"gvpack"};
+        for(auto& path : groupPaths) pack.push_back(path + ".laid.dot");
+        std::string packedPath = graphPath + "_packed.dot";
+        int packStatus = run(pack, packedPath, deadline);
+        if (packStatus == 0) packStatus = run({"neato", "-s", "-n2", "-Tsvg", packedPath}, graphPath + ".svg", deadline);
+        // out of time is final, anything else falls back to the whole graph
+        if (packStatus < 0) result = Result::plainDot;
+        else if (packStatus > 0) result = Result::failed;
+        std::remove( packedPath.c_str() );
+    }
+
+    for(auto& path : groupPaths){
+        std::remove( (path + ".dot").c_str() );
+        std::remove( (path + ".laid.dot").c_str() );
+    }
+    return result;
+}
+
+
+int GraphRenderer::run(const std::vector<std::string>& args, const std::string& outputPath, Deadline deadline){
+    bool limited = deadline != noDeadline;
+    if (limited && Clock::now() >= deadline) return -1;
+    std::vector<char*> argv;
+    for(auto& arg : args) argv.push_back( const_cast<char*>(arg.c_str()) );
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    pid_t pid;
+    int error = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (error != 0) return 127;
+
+    // poll with a growing interval: short layouts return quickly, long ones cost few wakeups
+    auto interval = std::chrono::milliseconds(1);
+    int status;
+    while (true){
+        pid_t done = waitpid(pid, &status, limited ? WNOHANG : 0);
+        if (done == pid) return WIFEXITED(status) ? WEXITSTATUS(status) : 128;
+        if (done < 0 && errno != EINTR) return 128;
+        if (limited && Clock::now() > deadline){
+            kill(pid, SIGKILL);
+            waitpid(pid, &status, 0);
+            return -1;
+        }
+        std::this_thread::sleep_for(interval);
+        interval = std::min(2*interval, std::chrono::milliseconds(20));
+    }
+}
+
+
+void GraphRenderer::print(std::ostream& report) const{
+    report<<"Rendering: "<<_nRendered<<" graphs laid out, "<<_nReduced<<" with reduced layout and "<<_nPlainDot<<" left as plain DOT after exceeding "<<_timeout<<" s";
+    if (_nFailed > 0) report<<", "<<_nFailed<<" failed";
+    if (_nParallel > 0) report<<", "<<_nParallel<<" laid out per component on "<<_nThreads<<" threads";
+    report<<". Slowest graph took "<<_maxSeconds<<" s"<<std::endl;
+}
@@ -0,0 +1,174 @@
+#include "GraphRing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    constexpr char magic[8] = {'D', 'C', 'R', 'I', 'N', 'G', '\0', '\0'};
+    constexpr uint32_t version = 2;
+}
+
+// lock-free 64-bit atomics work across processes mapping the same memory
+struct GraphRing::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t nSlots;
+    uint64_t slotSize;
+    int32_t viewerPid;
+    //graphs published and consumed so far, slot of graph i is i % nSlots
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+};
+
+struct GraphRing::Slot {
+    int32_t run;
+    int32_t event;
+    uint32_t nameSize;
+    uint32_t graphSize;
+    //name followed by the graph text, up to slotSize
+    char data[1];
+};
+
+
+GraphRing::~GraphRing(){
+    close();
+}
+
+
+GraphRing::Slot* GraphRing::slot(uint64_t i) const{
+    char* slots = reinterpret_cast<char*>(_header) + sizeof(Header);
+    return reinterpret_cast<Slot*>(slots + (i % _header->nSlots) * _header->slotSize);
+}
+
+
+bool GraphRing::create(const std::string& name, int nSlots, size_t slotSize){
+    close();
+    slotSize = (std::max(slotSize, sizeof(Slot)) + 63) & ~size_t(63);
+    _name = "/" + name;
+    shm_unlink( _name.c_str() );
+    int fd = shm_open(_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) return false;
+    _size = sizeof(Header) + nSlots*slotSize;
+    void* data = MAP_FAILED;
+    if (ftruncate(fd, _size) == 0) data = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED){
+        shm_unlink( _name.c_str() );
+        return false;
+    }
+
+    _header = new (data) Header{};
+    _header->version = version;
+    _header->nSlots = nSlots;
+    _header->slotSize = slotSize;
+    _header->viewerPid = getpid();
+    _header->head.store(0);
+    _header->tail.store(0);
+    // the producer checks the magic last
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(_header->magic, magic, sizeof(magic));
+    _owner = true;
+    return true;
+}
+
+
+bool GraphRing::open(const std::string& name){
+    close();
+    _name = "/" + name;
+    int fd = shm_open(_name.c_str(), O_RDWR, 0);
+    if (fd < 0) return false;
+    struct stat status;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &status) == 0 && size_t(status.st_size) >= sizeof(Header)){
+        _size = status.st_size;
+        data = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (data == MAP_FAILED) return false;
+
+    _header = static_cast<Header*>(data);
+    bool valid = std::memcmp(_header->magic, magic, sizeof(magic)) == 0 && _header->version == version
+                 && sizeof(Header) + _header->nSlots*_header->slotSize <= _size;
+    // a ring left behind by a viewer that died
+    if ( !valid || kill(_header->viewerPid, 0) != 0 ){
+        close();
+        return false;
+    }
+    return true;
+}
+
+
+void GraphRing::close(){
+    if (_header != nullptr) munmap(_header, _size);
+    if (_owner) shm_unlink( _name.c_str() );
+    _header = nullptr;
+    _owner = false;
+    _size = 0;
+}
+
+
+bool GraphRing::publish(std::string_view graphName, int run, int event, std::string_view dotGraph, double wait){
+    if ( !isOpen() ) return false;
+    uint64_t head = _header->head.load(std::memory_order_relaxed);
+    auto isFull = [this, head](){return head - _header->tail.load(std::memory_order_acquire) >= _header->nSlots;};
+    // names are kept whole, they become file names of the viewer
+    bool fits = offsetof(Slot, data) + graphName.size() + dotGraph.size() <= _header->slotSize;
+    bool alive = kill(_header->viewerPid, 0) == 0;
+    if (fits && alive && wait > 0. && isFull()){
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::duration<double>(wait) );
+        while (isFull() && alive && std::chrono::steady_clock::now() < deadline){
+            std::this_thread::sleep_for( std::chrono::milliseconds(5) );
+            alive = kill(_header->viewerPid, 0) == 0;
+        }
+    }
+    if (isFull() || !fits || !alive){
+        ++_nRejected;
+        return false;
+    }
+
+    Slot* s = slot(head);
+    s->run = run;
+    s->event = event;
+    s->nameSize = graphName.size();
+    std::memcpy(s->data, graphName.data(), graphName.size());
+    s->graphSize = dotGraph.size();
+    std::memcpy(s->data + graphName.size(), dotGraph.data(), dotGraph.size());
+    _header->head.store(head + 1, std::memory_order_release);
+    ++_nPublished;
+    return true;
+}
+
+
+bool GraphRing::consume(std::string& graphName, int& run, int& event, std::string& dotGraph){
+    if ( !isOpen() ) return false;
+    uint64_t tail = _header->tail.load(std::memory_order_relaxed);
+    if (tail == _header->head.load(std::memory_order_acquire)) return false;
+
+    const Slot* s = slot(tail);
+    run = s->run;
+    event = s->event;
+    graphName.assign(s->data, s->nameSize);
+    dotGraph.assign(s->data + s->nameSize, s->graphSize);
+    _header->tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+
+bool GraphRing::empty() const{
+    if ( !isOpen() ) return true;
+    return _header->tail.load(std::memory_order_relaxed) == _header->head.load(std::memory_order_acquire);
+}
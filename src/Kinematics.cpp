@@ -0,0 +1,48 @@
+#include "Kinematics.hpp"
+
+#include <cmath>
+#include <limits>
+
+void Kinematics::allocate(std::pmr::memory_resource* resource, const McGraph& graph){
+    n = graph.nParticles;
+    vx = graph.vx;
+    vy = graph.vy;
+    vz = graph.vz;
+    ex = graph.ex;
+    ey = graph.ey;
+    ez = graph.ez;
+    px = graph.px;
+    py = graph.py;
+    pz = graph.pz;
+    double** arrays[] = {&distance, &pt, &decayLength, &eta};
+    for(auto array : arrays) *array = static_cast<double*>( resource->allocate(n*sizeof(double), alignment) );
+}
+
+namespace {
+    // restrict and no errno from sqrt (-fno-math-errno for this file) let the loop vectorize
+    void kinematicsKernel(int n, double ipx, double ipy, double ipz,
+                          const double* __restrict vx, const double* __restrict vy, const double* __restrict vz,
+                          const double* __restrict ex, const double* __restrict ey, const double* __restrict ez,
+                          const double* __restrict px, const double* __restrict py,
+                          double* __restrict distance, double* __restrict pt, double* __restrict decayLength){
+        for(int i=0; i<n; ++i){
+            double dx = vx[i] - ipx, dy = vy[i] - ipy, dz = vz[i] - ipz;
+            distance[i] = std::sqrt(dx*dx + dy*dy + dz*dz);
+            pt[i] = std::sqrt(px[i]*px[i] + py[i]*py[i]);
+            double lx = ex[i] - vx[i], ly = ey[i] - vy[i], lz = ez[i] - vz[i];
+            decayLength[i] = std::sqrt(lx*lx + ly*ly + lz*lz);
+        }
+    }
+}
+
+void Kinematics::compute(const double* ip){
+    kinematicsKernel(n, ip[0], ip[1], ip[2], vx, vy, vz, ex, ey, ez, px, py, distance, pt, decayLength);
+}
+
+void Kinematics::computeEta(){
+    for(int i=0; i<n; ++i){
+        // particles along the beam get an infinite eta of the right sign
+        if (pt[i] == 0.) eta[i] = std::copysign(std::numeric_limits<double>::infinity(), pz[i]);
+        else eta[i] = std::asinh(pz[i] / pt[i]);
+    }
+}
@@ -0,0 +1,171 @@
+#include "LcioAdapter.hpp"
+#include "Kinematics.hpp"
+
+#include "EVENT/LCRelation.h"
+#include "EVENT/Vertex.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace std;
+using EVENT::MCParticle;
+
+namespace {
+    template <typename T>
+    void release(std::pmr::vector<T>& v){
+        std::pmr::vector<T>( v.get_allocator() ).swap(v);
+    }
+}
+
+
+LcioAdapter::LcioAdapter(std::pmr::memory_resource* resource) :
+    _resource(resource),
+    _particles(resource),
+    _index(resource),
+    _pdg(resource),
+    _generatorStatus(resource),
+    _parentOffsets(resource),
+    _parents(resource),
+    _daughterOffsets(resource),
+    _daughters(resource),
+    _trackOffsets(resource),
+    _trackMc(resource),
+    _reconstructedMc(resource){}
+
+
+void LcioAdapter::clear(){
+    release(_particles);
+    std::pmr::unordered_map<MCParticle*, int>( _index.get_allocator() ).swap(_index);
+    release(_pdg);
+    release(_generatorStatus);
+    release(_parentOffsets);
+    release(_parents);
+    release(_daughterOffsets);
+    release(_daughters);
+    release(_trackOffsets);
+    release(_trackMc);
+    release(_reconstructedMc);
+    _graph = McGraph{};
+    _tracks = VertexTracks{};
+}
+
+
+int LcioAdapter::index(EVENT::MCParticle* mc) const{
+    auto found = _index.find(mc);
+    return found == _index.end() ? -1 : found->second;
+}
+
+
+const McGraph& LcioAdapter::setMcParticles(EVENT::LCCollection* mcCol){
+    int n = mcCol->getNumberOfElements();
+    _particles.resize(n);
+    _index.clear();
+    _index.reserve(n);
+    for(int i=0; i<n; ++i){
+        _particles[i] = static_cast<MCParticle*> (mcCol->getElementAt(i));
+        _index[ _particles[i] ] = i;
+    }
+
+    _pdg.resize(n);
+    _generatorStatus.resize(n);
+    // vertex, endpoint and momentum go straight into the x, y, z arrays read by the kinematics kernel
+    double* columns[9];
+    for(auto& column : columns) column = static_cast<double*>( _resource->allocate(n*sizeof(double), Kinematics::alignment) );
+    _parentOffsets.assign(1, 0);
+    _daughterOffsets.assign(1, 0);
+    _parents.clear();
+    _daughters.clear();
+    for(int i=0; i<n; ++i){
+        MCParticle* mc = _particles[i];
+        _pdg[i] = mc->getPDG();
+        _generatorStatus[i] = mc->getGeneratorStatus();
+        const double* vertex = mc->getVertex();
+        const double* endpoint = mc->getEndpoint();
+        const double* momentum = mc->getMomentum();
+        for(int k=0; k<3; ++k){
+            columns[k][i] = vertex[k];
+            columns[3+k][i] = endpoint[k];
+            columns[6+k][i] = momentum[k];
+        }
+        // relations to particles outside of the collection are dropped
+        for(auto parent : mc->getParents() ){
+            int p = index(parent);
+            if (p >= 0) _parents.push_back(p);
+        }
+        for(auto daughter : mc->getDaughters() ){
+            int d = index(daughter);
+            if (d >= 0) _daughters.push_back(d);
+        }
+        _parentOffsets.push_back( _parents.size() );
+        _daughterOffsets.push_back( _daughters.size() );
+    }
+    _graph.nParticles = n;
+    _graph.pdg = _pdg.data();
+    _graph.generatorStatus = _generatorStatus.data();
+    _graph.parentOffsets = _parentOffsets.data();
+    _graph.parents = _parents.data();
+    _graph.daughterOffsets = _daughterOffsets.data();
+    _graph.daughters = _daughters.data();
+    _graph.vx = columns[0];
+    _graph.vy = columns[1];
+    _graph.vz = columns[2];
+    _graph.ex = columns[3];
+    _graph.ey = columns[4];
+    _graph.ez = columns[5];
+    _graph.px = columns[6];
+    _graph.py = columns[7];
+    _graph.pz = columns[8];
+    return _graph;
+}
+
+
+const VertexTracks& LcioAdapter::setVertices(EVENT::LCCollection* vertices, const UTIL::LCRelationNavigator& navRecoToMc){
+    int nVertices = vertices->getNumberOfElements();
+    _trackOffsets.assign(1, 0);
+    _trackMc.clear();
+    for(int j=0; j<nVertices; ++j){
+        EVENT::Vertex* vertex = static_cast<EVENT::Vertex*> (vertices->getElementAt(j));
+        for(auto pfo : vertex->getAssociatedParticle()->getParticles() ){
+            MCParticle* mc = getMcMaxTrackWeight(pfo, navRecoToMc);
+            _trackMc.push_back( mc == nullptr ? -1 : index(mc) );
+        }
+        _trackOffsets.push_back( _trackMc.size() );
+    }
+
+    _tracks.nVertices = nVertices;
+    _tracks.trackOffsets = _trackOffsets.data();
+    _tracks.trackMc = _trackMc.data();
+    return _tracks;
+}
+
+
+const VertexTracks& LcioAdapter::setReconstructedParticles(EVENT::LCCollection* recoMcLinks, const UTIL::LCRelationNavigator& navRecoToMc){
+    int nLinks = recoMcLinks->getNumberOfElements();
+    _reconstructedMc.clear();
+    // a particle has one link per MC contribution
+    std::pmr::unordered_set<EVENT::LCObject*> seen( _reconstructedMc.get_allocator().resource() );
+    seen.reserve(nLinks);
+    for(int i=0; i<nLinks; ++i){
+        EVENT::LCObject* from = static_cast<EVENT::LCRelation*> (recoMcLinks->getElementAt(i))->getFrom();
+        if ( !seen.insert(from).second ) continue;
+        EVENT::ReconstructedParticle* pfo = static_cast<EVENT::ReconstructedParticle*> (from);
+        if ( pfo->getTracks().empty() ) continue;
+        MCParticle* mc = getMcMaxTrackWeight(pfo, navRecoToMc);
+        _reconstructedMc.push_back( mc == nullptr ? -1 : index(mc) );
+    }
+
+    _tracks.hasReconstructed = true;
+    _tracks.nReconstructed = _reconstructedMc.size();
+    _tracks.reconstructedMc = _reconstructedMc.data();
+    return _tracks;
+}
+
+
+EVENT::MCParticle* LcioAdapter::getMcMaxTrackWeight(EVENT::ReconstructedParticle* pfo, const UTIL::LCRelationNavigator& nav){
+    const vector<EVENT::LCObject*>& mcs = nav.getRelatedToObjects(pfo);
+    const vector<float>& weights = nav.getRelatedToWeights(pfo);
+    if ( mcs.empty() ) return nullptr;
+    //get index of highest TRACK weight MC particle
+    int i = std::max_element(weights.begin(), weights.end(), [](float a, float b){return (int(a)%10000)/1000. < (int(b)%10000)/1000.;}) - weights.begin();
+    return static_cast<MCParticle*> ( mcs[i] );
+}
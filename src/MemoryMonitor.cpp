@@ -0,0 +1,118 @@
+#include "MemoryMonitor.hpp"
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <string>
+
+using namespace std;
+
+void MemoryMonitor::enable(){
+    _enabled = true;
+    // provided by the preloaded DecayChainAllocCounter library
+    _counts = reinterpret_cast<void (*)(unsigned long*, unsigned long*)>( dlsym(RTLD_DEFAULT, "decayChainAllocationCounts") );
+}
+
+void MemoryMonitor::beginEvent(){
+    if ( !_enabled ) return;
+    _stageAllocations.fill(0);
+    _stageBytes.fill(0);
+    readCounts(_eventStartAllocations, _eventStartBytes);
+}
+
+void MemoryMonitor::beginStage(ProcessingStage){
+    if ( !_enabled ) return;
+    readCounts(_stageStartAllocations, _stageStartBytes);
+}
+
+void MemoryMonitor::endStage(ProcessingStage stage){
+    if ( !_enabled ) return;
+    uint64_t nAllocations, nBytes;
+    readCounts(nAllocations, nBytes);
+    _stageAllocations[int(stage)] += nAllocations - _stageStartAllocations;
+    _stageBytes[int(stage)] += nBytes - _stageStartBytes;
+}
+
+void MemoryMonitor::endEvent(){
+    if ( !_enabled ) return;
+    uint64_t nAllocations, nBytes;
+    readCounts(nAllocations, nBytes);
+    _allocationsPerEvent.fill(nAllocations - _eventStartAllocations);
+    _bytesPerEvent.fill(nBytes - _eventStartBytes);
+    for(int i=0; i<nProcessingStages; ++i){
+        _allocationsPerStage[i].fill(_stageAllocations[i]);
+        _bytesPerStage[i].fill(_stageBytes[i]);
+    }
+    _rss.fill( getRss() );
+}
+
+void MemoryMonitor::readCounts(uint64_t& nAllocations, uint64_t& nBytes) const{
+    unsigned long allocations = 0, bytes = 0;
+    if (_counts) _counts(&allocations, &bytes);
+    nAllocations = allocations;
+    nBytes = bytes;
+}
+
+uint64_t MemoryMonitor::getRss(){
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0, resident = 0;
+    statm>>size>>resident;
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+uint64_t MemoryMonitor::getPeakRss(){
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while( std::getline(status, line) ){
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::stoull( line.substr(6) ) * 1024;
+    }
+    return 0;
+}
+
+void MemoryMonitor::Distribution::fill(uint64_t value){
+    int bin = 0;
+    while ( bin < 64 && (value >> bin) != 0 ) ++bin;
+    ++bins[bin];
+    ++n;
+    sum += value;
+    if (value > max) max = value;
+}
+
+uint64_t MemoryMonitor::Distribution::quantile(double fraction) const{
+    // upper edge of the log2 bin holding the quantile
+    uint64_t needed = fraction * n;
+    uint64_t seen = 0;
+    for(int bin=0; bin<65; ++bin){
+        seen += bins[bin];
+        if (seen > needed) return bin == 0 ? 0 : std::min<uint64_t>(max, (bin == 64 ? ~0ULL : (1ULL << bin) - 1));
+    }
+    return max;
+}
+
+void MemoryMonitor::printDistribution(std::ostream& out, const char* name, const Distribution& distribution, const char* unit){
+    double mean = distribution.n > 0 ? distribution.sum / distribution.n : 0.;
+    out<<"    "<<std::left<<std::setw(36)<<name<<std::right<<std::fixed<<std::setprecision(1)
+       <<" mean "<<std::setw(12)<<mean
+       <<" p50 < "<<std::setw(12)<<distribution.quantile(0.5)
+       <<" p99 < "<<std::setw(12)<<distribution.quantile(0.99)
+       <<" max "<<std::setw(12)<<distribution.max<<" "<<unit<<endl;
+}
+
+void MemoryMonitor::print(std::ostream& out) const{
+    if ( !_enabled ) return;
+    out<<"Memory accounting over "<<_rss.n<<" events"<<endl;
+    if (_counts){
+        printDistribution(out, "allocations per event", _allocationsPerEvent, "");
+        printDistribution(out, "allocated per event", _bytesPerEvent, "bytes");
+        for(int i=0; i<nProcessingStages; ++i){
+            printDistribution(out, (std::string("allocations in ") + processingStageNames[i]).c_str(), _allocationsPerStage[i], "");
+            printDistribution(out, (std::string("allocated in ") + processingStageNames[i]).c_str(), _bytesPerStage[i], "bytes");
+        }
+    }
+    else out<<"    no allocation counts, preload libDecayChainAllocCounter.so to get them"<<endl;
+    printDistribution(out, "RSS after event", _rss, "bytes");
+    out<<"    peak RSS "<<getPeakRss()<<" bytes"<<endl;
+}
@@ -0,0 +1,102 @@
+#include "PerfCounters.hpp"
+
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+    constexpr const char* counterNames[PerfCounters::nCounters] = {"cycles", "instructions", "cache misses", "branch misses"};
+    constexpr uint64_t counterConfigs[PerfCounters::nCounters] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+    int openCounter(uint64_t config){
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        // user space only works with the default perf_event_paranoid
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+}
+
+
+PerfCounters::~PerfCounters(){
+    for(auto fd : _fds){
+        if (fd >= 0) close(fd);
+    }
+}
+
+
+int PerfCounters::enable(){
+    int nOpen = 0;
+    for(int i=0; i<nCounters; ++i){
+        _fds[i] = openCounter(counterConfigs[i]);
+        if (_fds[i] >= 0) ++nOpen;
+    }
+    _enabled = nOpen > 0;
+    return nOpen;
+}
+
+
+void PerfCounters::read(std::array<double, nCounters>& values) const{
+    for(int i=0; i<nCounters; ++i){
+        values[i] = 0.;
+        uint64_t data[3];
+        if (_fds[i] < 0 || ::read(_fds[i], data, sizeof(data)) != sizeof(data)) continue;
+        // value, time enabled, time running
+        values[i] = data[2] > 0 ? double(data[0]) * data[1] / data[2] : 0.;
+    }
+}
+
+
+void PerfCounters::beginStage(ProcessingStage){
+    if ( !_enabled ) return;
+    read(_stageStart);
+}
+
+
+void PerfCounters::endStage(ProcessingStage stage){
+    if ( !_enabled ) return;
+    std::array<double, nCounters> values;
+    read(values);
+    int s = int(stage);
+    ++_nCalls[s];
+    for(int i=0; i<nCounters; ++i) _stageTotals[s][i] += values[i] - _stageStart[i];
+}
+
+
+void PerfCounters::print(std::ostream& out) const{
+    if ( !_enabled ) return;
+    out<<"Hardware counters per stage call (user space)"<<endl;
+    out<<"    "<<std::left<<std::setw(16)<<"stage"<<std::right<<std::setw(10)<<"calls";
+    for(int i=0; i<nCounters; ++i) out<<std::setw(16)<<counterNames[i];
+    out<<std::setw(8)<<"IPC"<<std::setw(12)<<"miss/kinst"<<std::setw(12)<<"br/kinst"<<endl;
+
+    for(int s=0; s<nProcessingStages; ++s){
+        if (_nCalls[s] == 0) continue;
+        const std::array<double, nCounters>& totals = _stageTotals[s];
+        out<<"    "<<std::left<<std::setw(16)<<processingStageNames[s]<<std::right<<std::setw(10)<<_nCalls[s]<<std::fixed<<std::setprecision(0);
+        for(int i=0; i<nCounters; ++i){
+            if (_fds[i] >= 0) out<<std::setw(16)<<totals[i] / _nCalls[s];
+            else out<<std::setw(16)<<"n/a";
+        }
+        out<<std::setprecision(2);
+        double kiloInstructions = totals[instructions] / 1000.;
+        if (_fds[cycles] >= 0 && _fds[instructions] >= 0 && totals[cycles] > 0.) out<<std::setw(8)<<totals[instructions] / totals[cycles];
+        else out<<std::setw(8)<<"n/a";
+        if (_fds[cacheMisses] >= 0 && kiloInstructions > 0.) out<<std::setw(12)<<totals[cacheMisses] / kiloInstructions;
+        else out<<std::setw(12)<<"n/a";
+        if (_fds[branchMisses] >= 0 && kiloInstructions > 0.) out<<std::setw(12)<<totals[branchMisses] / kiloInstructions;
+        else out<<std::setw(12)<<"n/a";
+        out<<endl;
+    }
+}
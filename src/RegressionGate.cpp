@@ -0,0 +1,110 @@
+#include "RegressionGate.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+
+using namespace std;
+
+void RegressionGate::setup(Mode mode, const std::string& directory, double margin){
+    _mode = mode;
+    _directory = directory;
+    _margin = margin;
+    if (_mode == Mode::record) std::filesystem::create_directories(_directory);
+}
+
+std::string RegressionGate::goldenName(const std::string& collection, int run, int event){
+    return collection + "_r" + std::to_string(run) + "_e" + std::to_string(event) + ".dot";
+}
+
+void RegressionGate::checkGraph(const std::string& collection, int run, int event, std::string_view dotGraph){
+    if (_mode == Mode::off) return;
+    ++_nGraphs;
+    std::string name = goldenName(collection, run, event);
+    if (_mode == Mode::record){
+        std::ofstream golden(_directory + "/" + name);
+        golden<<dotGraph;
+        return;
+    }
+
+    _produced.insert(name);
+    std::ifstream golden(_directory + "/" + name);
+    if ( !golden ){
+        ++_nMissing;
+        return;
+    }
+    std::string expected( (std::istreambuf_iterator<char>(golden)), std::istreambuf_iterator<char>() );
+    if (expected != dotGraph) ++_nMismatches;
+}
+
+void RegressionGate::addEvent(double seconds){
+    ++_nEvents;
+    _seconds += seconds;
+}
+
+bool RegressionGate::finish(bool hasAllocations, uint64_t nAllocations, std::ostream& report){
+    if (_mode == Mode::off) return true;
+    if (_nEvents == 0){
+        if (_mode == Mode::compare) report<<"Regression gate saw no events"<<endl;
+        return _mode == Mode::record;
+    }
+    double secondsPerEvent = _seconds / _nEvents;
+    double allocationsPerEvent = double(nAllocations) / _nEvents;
+    std::string budgetPath = _directory + "/budgets.txt";
+
+    if (_mode == Mode::record){
+        std::ofstream budgets(budgetPath);
+        budgets<<"seconds_per_event "<<secondsPerEvent<<endl;
+        if (hasAllocations) budgets<<"allocations_per_event "<<allocationsPerEvent<<endl;
+        report<<"Recorded "<<_nGraphs<<" golden graphs and budgets of "<<_nEvents<<" events in "<<_directory<<endl;
+        return true;
+    }
+
+    // golden graphs this run did not produce at all
+    long nNotProduced = 0;
+    std::error_code error;
+    for(auto& entry : std::filesystem::directory_iterator(_directory, error)){
+        std::string name = entry.path().filename().string();
+        if (entry.path().extension() == ".dot" && _produced.count(name) == 0) ++nNotProduced;
+    }
+
+    bool pass = true;
+    report<<"Regression gate over "<<_nEvents<<" events: "<<_nGraphs<<" graphs, "<<_nMismatches<<" differ from golden, "<<_nMissing<<" without golden, "<<nNotProduced<<" golden not produced"<<endl;
+    if (_nMismatches > 0 || _nMissing > 0 || nNotProduced > 0) pass = false;
+
+    std::ifstream budgets(budgetPath);
+    if ( !budgets ){
+        report<<"    no budgets in "<<budgetPath<<endl;
+        return false;
+    }
+    std::string key;
+    double budget;
+    bool hasTimeBudget = false;
+    bool hasAllocationBudget = false;
+    while (budgets>>key>>budget){
+        double measured;
+        if (key == "seconds_per_event"){
+            measured = secondsPerEvent;
+            hasTimeBudget = true;
+        }
+        else if (key == "allocations_per_event" && hasAllocations){
+            measured = allocationsPerEvent;
+            hasAllocationBudget = true;
+        }
+        else continue;
+        bool withinBudget = measured <= budget * (1. + _margin);
+        report<<"    "<<key<<" "<<measured<<" budget "<<budget<<" margin "<<_margin<<(withinBudget ? " ok" : " EXCEEDED")<<endl;
+        if ( !withinBudget ) pass = false;
+    }
+    // a budget that was never recorded must not pass silently, record again with the counter preloaded
+    if ( !hasTimeBudget ){
+        report<<"    seconds_per_event has no budget in "<<budgetPath<<endl;
+        pass = false;
+    }
+    if (hasAllocations && !hasAllocationBudget){
+        report<<"    allocations_per_event "<<allocationsPerEvent<<" has no budget in "<<budgetPath<<endl;
+        pass = false;
+    }
+    return pass;
+}
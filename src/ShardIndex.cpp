@@ -0,0 +1,112 @@
+#include "ShardIndex.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+void ShardIndex::addInput(const std::string& path, const std::vector<int>& runEvents){
+    ShardInput input;
+    input.path = path;
+    int nEvents = runEvents.size() / 2;
+    if (nEvents > 0){
+        input.firstRun = runEvents[0];
+        input.firstEvent = runEvents[1];
+        input.lastRun = runEvents[2*nEvents - 2];
+        input.lastEvent = runEvents[2*nEvents - 1];
+    }
+    int index = inputs.size();
+    inputs.push_back(input);
+    for(int i=0; i<nEvents; ++i) _inputEvents.push_back({runEvents[2*i], runEvents[2*i + 1], index});
+    // the first input of a (run, event) found twice wins, as Marlin reads it first
+    std::stable_sort(_inputEvents.begin(), _inputEvents.end());
+}
+
+int ShardIndex::findInput(int run, int event) const{
+    std::array<int, 3> key{run, event, -1};
+    auto found = std::lower_bound(_inputEvents.begin(), _inputEvents.end(), key);
+    if (found == _inputEvents.end() || (*found)[0] != run || (*found)[1] != event) return -1;
+    return (*found)[2];
+}
+
+void ShardIndex::add(int run, int event, const std::string& collection, const std::string& file){
+    entries.push_back({run, event, findInput(run, event), collection, file});
+}
+
+void ShardIndex::merge(const ShardIndex& other){
+    // inputs of the other shard are renumbered into this one
+    std::vector<int> inputIndex;
+    for(auto& input : other.inputs){
+        auto found = std::find_if(inputs.begin(), inputs.end(), [&input](const ShardInput& a){return a.path == input.path;});
+        inputIndex.push_back(found - inputs.begin());
+        if (found == inputs.end()) inputs.push_back(input);
+        else if (found->firstRun < 0) *found = input;
+    }
+    for(auto entry : other.entries){
+        if (entry.input >= 0) entry.input = inputIndex[entry.input];
+        entries.push_back(entry);
+    }
+}
+
+void ShardIndex::sort(){
+    std::stable_sort(entries.begin(), entries.end(), [](const ShardEntry& a, const ShardEntry& b){
+        if (a.run != b.run) return a.run < b.run;
+        if (a.event != b.event) return a.event < b.event;
+        return a.collection < b.collection;
+    });
+}
+
+int ShardIndex::countDuplicates() const{
+    int nDuplicates = 0;
+    for(size_t i=1; i<entries.size(); ++i){
+        const ShardEntry& a = entries[i-1];
+        const ShardEntry& b = entries[i];
+        if (a.run == b.run && a.event == b.event && a.collection == b.collection) ++nDuplicates;
+    }
+    return nDuplicates;
+}
+
+bool ShardIndex::write(const std::string& path) const{
+    std::ofstream out(path);
+    if ( !out ) return false;
+    out<<"#DecayChainDrawer shard index"<<endl;
+    out<<"name "<<name<<endl;
+    out<<"#input <first run> <first event> <last run> <last event> <path>, numbered from 0 in order"<<endl;
+    for(auto& input : inputs) out<<"input "<<input.firstRun<<" "<<input.firstEvent<<" "<<input.lastRun<<" "<<input.lastEvent<<" "<<input.path<<endl;
+    out<<"entries "<<entries.size()<<endl;
+    out<<"#entry <run> <event> <input> <collection> <file>"<<endl;
+    for(auto& entry : entries) out<<"entry "<<entry.run<<" "<<entry.event<<" "<<entry.input<<" "<<entry.collection<<" "<<entry.file<<endl;
+    return bool(out);
+}
+
+bool ShardIndex::read(const std::string& path){
+    std::ifstream in(path);
+    if ( !in ) return false;
+    std::filesystem::path dir = std::filesystem::absolute(path).parent_path();
+
+    std::string line;
+    while( std::getline(in, line) ){
+        if ( line.empty() || line[0] == '#' ) continue;
+        std::istringstream fields(line);
+        std::string key;
+        fields>>key>>std::ws;
+        if (key == "name") std::getline(fields, name);
+        else if (key == "input"){
+            ShardInput input;
+            fields>>input.firstRun>>input.firstEvent>>input.lastRun>>input.lastEvent>>std::ws;
+            std::getline(fields, input.path);
+            inputs.push_back(input);
+        }
+        else if (key == "entry"){
+            ShardEntry entry;
+            fields>>entry.run>>entry.event>>entry.input>>entry.collection>>std::ws;
+            std::getline(fields, entry.file);
+            entry.file = (dir / entry.file).lexically_normal().string();
+            if ( entry.input >= int(inputs.size()) ) entry.input = -1;
+            entries.push_back(entry);
+        }
+    }
+    return true;
+}
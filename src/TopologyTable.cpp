@@ -0,0 +1,81 @@
+#include "TopologyTable.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+using namespace std;
+
+TopologyTable::TopologyTable(size_t capacity){
+    size_t n = 16;
+    while (n < capacity) n *= 2;
+    _slots.assign(n, Entry{});
+}
+
+TopologyTable::Entry& TopologyTable::find(uint64_t hash){
+    // 0 marks an empty slot
+    if (hash == 0) hash = 1;
+    if ( 10*(_size + 1) > 7*_slots.size() ) grow();
+
+    size_t mask = _slots.size() - 1;
+    size_t i = hash & mask;
+    while ( _slots[i].hash != 0 && _slots[i].hash != hash ) i = (i + 1) & mask;
+
+    Entry& entry = _slots[i];
+    if (entry.hash == 0){
+        entry.hash = hash;
+        entry.label = -1;
+        ++_size;
+    }
+    return entry;
+}
+
+void TopologyTable::add(Entry& entry, int run, int event){
+    ++entry.count;
+    ++_total;
+    if (entry.nStoredExamples < nExamples) entry.examples[entry.nStoredExamples++] = {run, event};
+}
+
+void TopologyTable::setLabel(Entry& entry, const std::string& label){
+    entry.label = _labels.size();
+    _labels.push_back(label);
+}
+
+void TopologyTable::grow(){
+    std::vector<Entry> old( 2*_slots.size(), Entry{} );
+    old.swap(_slots);
+    size_t mask = _slots.size() - 1;
+    for(auto& entry : old){
+        if (entry.hash == 0) continue;
+        size_t i = entry.hash & mask;
+        while ( _slots[i].hash != 0 ) i = (i + 1) & mask;
+        _slots[i] = entry;
+    }
+}
+
+std::vector<const TopologyTable::Entry*> TopologyTable::ranked() const{
+    std::vector<const Entry*> entries;
+    entries.reserve(_size);
+    for(auto& entry : _slots){
+        if (entry.hash != 0) entries.push_back(&entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry* a, const Entry* b){
+        return a->count > b->count || (a->count == b->count && a->hash < b->hash);
+    });
+    return entries;
+}
+
+bool TopologyTable::write(const std::string& path) const{
+    std::ofstream out(path);
+    if ( !out ) return false;
+    out<<"# "<<_total<<" vertices, "<<_size<<" distinct topologies"<<endl;
+    out<<"# rank count fraction nBChains hash examples(run:event) topology"<<endl;
+    int rank = 0;
+    for(auto entry : ranked()){
+        out<<++rank<<" "<<entry->count<<" "<<std::fixed<<std::setprecision(5)<<double(entry->count)/_total<<" "<<entry->nBChains<<" ";
+        out<<std::hex<<std::setw(16)<<std::setfill('0')<<entry->hash<<std::dec<<std::setfill(' ')<<" ";
+        for(int i=0; i<entry->nStoredExamples; ++i) out<<(i == 0 ? "" : ",")<<entry->examples[i].first<<":"<<entry->examples[i].second;
+        out<<" "<<label(*entry)<<endl;
+    }
+    return bool(out);
+}
@@ -0,0 +1,73 @@
+#include "VertexingHistograms.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+
+using namespace std;
+
+namespace {
+    int fractionBin(double fraction){
+        // a fraction of 1 belongs to the last bin
+        return std::min(int(fraction * VertexingHistograms::nFractionBins), VertexingHistograms::nFractionBins - 1);
+    }
+
+    int countBin(int count){
+        return std::min(count, VertexingHistograms::nCountBins - 1);
+    }
+}
+
+
+void VertexingHistograms::fill(const VertexMetrics* metrics, int n){
+    for(int i=0; i<n; ++i){
+        const VertexMetrics& vertex = metrics[i];
+        ++_nVertices;
+        _nTracks += vertex.nTracks;
+        _nDominant += vertex.nDominant;
+        _nFound += vertex.nFound;
+        _nMissed += vertex.nMissed;
+        if (vertex.nChains > 1) ++_nMerged;
+        ++_chains[ countBin(vertex.nChains) ];
+        ++_missed[ countBin(vertex.nMissed) ];
+        if (vertex.nTracks > 0) ++_purity[ fractionBin( double(vertex.nDominant) / vertex.nTracks ) ];
+        // vertices without any linked track have no dominant chain
+        if (vertex.nFound > 0) ++_efficiency[ fractionBin( double(vertex.nFound) / (vertex.nFound + vertex.nMissed) ) ];
+    }
+}
+
+
+double VertexingHistograms::purity() const{
+    return _nTracks == 0 ? 0. : double(_nDominant) / _nTracks;
+}
+
+
+double VertexingHistograms::efficiency() const{
+    uint64_t nTotal = _nFound + _nMissed;
+    return nTotal == 0 ? 0. : double(_nFound) / nTotal;
+}
+
+
+double VertexingHistograms::mergedFraction() const{
+    long n = nVertices();
+    return n == 0 ? 0. : double(_nMerged) / n;
+}
+
+
+bool VertexingHistograms::write(const std::string& path) const{
+    std::ofstream out(path);
+    if ( !out ) return false;
+    out<<"# "<<nVertices()<<" vertices, purity "<<std::fixed<<std::setprecision(4)<<purity()<<", efficiency "<<efficiency()<<", merged "<<mergedFraction()<<endl;
+    out<<"# histogram bin(lower edge) vertices, the last chains and missed bins include everything above"<<endl;
+    for(int b=0; b<nFractionBins; ++b) out<<"purity "<<std::setprecision(2)<<double(b) / nFractionBins<<" "<<_purity[b]<<endl;
+    for(int b=0; b<nFractionBins; ++b) out<<"efficiency "<<std::setprecision(2)<<double(b) / nFractionBins<<" "<<_efficiency[b]<<endl;
+    for(int b=0; b<nCountBins; ++b) out<<"chains "<<b<<" "<<_chains[b]<<endl;
+    for(int b=0; b<nCountBins; ++b) out<<"missed "<<b<<" "<<_missed[b]<<endl;
+    return bool(out);
+}
+
+
+void VertexingHistograms::print(std::ostream& out) const{
+    out<<nVertices()<<" vertices: purity "<<std::fixed<<std::setprecision(3)<<purity()<<", efficiency "<<efficiency();
+    out<<", "<<std::setprecision(1)<<100. * mergedFraction()<<"% merging several decay chains, "<<_nMissed<<" missed tracks"<<endl;
+}